@@ -0,0 +1,86 @@
+// Copyright 2020 Kriukov Dmitry
+
+#ifndef MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_HASHLIFE_H_
+#define MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_HASHLIFE_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "include/game-of-life.h"
+
+// Unbounded universe advanced by Gosper's HashLife. The plane is a quadtree
+// whose equal subtrees are shared (hash-consed), and the advanced centre of
+// every node is memoized, so regular patterns run 2^40 generations and more
+// in little time. Cell (0, 0) is in the middle of the root node.
+class HashLifeUniverse {
+ public:
+  // When max_nodes nodes are cached, the ones unreachable from the pattern
+  // and from the step in progress are freed, also in the middle of a long
+  // Step or Run. The cache only grows past max_nodes, up to twice the nodes
+  // still in use, when more than half of it is in use.
+  explicit HashLifeUniverse(size_t max_nodes = 1048576);
+  ~HashLifeUniverse();
+
+  void SetCell(int64_t x, int64_t y, uchar cell);
+  uchar GetCell(int64_t x, int64_t y) const;
+  // Places the cells of grid with its cell (0, 0) at (x, y).
+  void Import(const GameOfLifeGrid& grid, int64_t x = 0, int64_t y = 0);
+  // The wight x height window of the universe that starts at (x, y).
+  GameOfLifeGrid Export(int64_t x, int64_t y, uint32_t wight,
+                        uint32_t height) const;
+
+  // Every Step advances 2^step_log generations.
+  void SetStep(uint32_t step_log_);
+  uint32_t GetStep() const;
+  void Step();
+  // Advances any number of generations, one power-of-two step per bit.
+  void Run(uint64_t generations);
+
+  uint64_t Generation() const;
+  uint64_t Population() const;
+  size_t NodeCount() const;
+  void CollectGarbage();
+
+ private:
+  struct Node;
+  struct NodeKey {
+    const Node* quadrants[4];
+    bool operator==(const NodeKey& key) const;
+  };
+  struct NodeKeyHash {
+    size_t operator()(const NodeKey& key) const;
+  };
+
+  HashLifeUniverse(const HashLifeUniverse&);
+  HashLifeUniverse& operator=(const HashLifeUniverse&);
+
+  Node* Join(Node* nw, Node* ne, Node* sw, Node* se);
+  // Keeps a node of a computation in progress alive through collections.
+  Node* Pin(Node* node);
+  Node* Empty(uint32_t level);
+  Node* Expand(Node* node);
+  Node* Center(Node* node);
+  Node* Result(Node* node);
+  Node* BaseResult(Node* node);
+  Node* Set(Node* node, uint64_t x, uint64_t y, bool alive);
+  bool Contains(int64_t x, int64_t y) const;
+  void Mark(Node* node);
+  void ExportNode(const Node* node, int64_t left, int64_t top, int64_t x,
+                  int64_t y, GameOfLifeGrid* grid) const;
+
+  std::unordered_map<NodeKey, Node*, NodeKeyHash> nodes;
+  std::vector<Node*> empty;
+  std::vector<Node*> pinned;
+  Node* dead;
+  Node* alive;
+  Node* root;
+  uint32_t step_log;
+  uint64_t generation;
+  size_t max_nodes;
+  // Join collects garbage when the cache reaches this size.
+  size_t collect_at;
+};
+
+#endif  // MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_HASHLIFE_H_
@@ -0,0 +1,131 @@
+// Copyright 2020 Kriukov Dmitry
+
+#ifndef MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_IO_H_
+#define MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_IO_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "include/game-of-life.h"
+
+// Receives the live cells of a pattern one by one while it is decoded.
+class PatternSink {
+ public:
+  virtual ~PatternSink() {}
+  virtual void Alive(int64_t x, int64_t y) = 0;
+};
+
+// Sets the decoded cells straight in a grid: GameOfLifeGrid, PackedLifeGrid,
+// SparseLifeGrid, HashLifeUniverse or anything else with SetCell(x, y, cell).
+// Pattern cell (0, 0) goes to (x, y) of the grid.
+template <class Grid>
+class GridSink : public PatternSink {
+ public:
+  explicit GridSink(Grid* grid_, int64_t x_ = 0, int64_t y_ = 0)
+    :grid(grid_), x(x_), y(y_) {}
+  void Alive(int64_t cell_x, int64_t cell_y) {
+    grid->SetCell(x + cell_x, y + cell_y, aliveCell);
+  }
+
+ private:
+  Grid* grid;
+  int64_t x;
+  int64_t y;
+};
+
+// What is known about a pattern after it has been read. For RLE the box is
+// the one from the header, for Life 1.06 it bounds the live cells.
+struct PatternInfo {
+  int64_t left;
+  int64_t top;
+  int64_t wight;
+  int64_t height;
+  uint64_t population;
+  std::string rule;
+};
+
+// Decoders of the RLE and Life 1.06 formats. They make one pass over the
+// text and throw on malformed input.
+PatternInfo ReadRle(const char* data, size_t size, PatternSink* sink);
+PatternInfo ReadLife106(const char* data, size_t size, PatternSink* sink);
+// Chooses the format by the "#Life 1.06" header line.
+PatternInfo ReadPattern(const char* data, size_t size, PatternSink* sink);
+// Maps the file into memory and decodes it, so that files of any size are
+// read without being copied.
+PatternInfo LoadPattern(const std::string& path, PatternSink* sink);
+// The pattern in a dense grid just big enough for its box.
+GameOfLifeGrid LoadGrid(const std::string& path);
+
+// Writes cells given row by row from the top left corner as RLE. Dead cells
+// at the end of a row and empty rows are not written, lines are at most 70
+// characters long.
+class RleWriter {
+ public:
+  RleWriter(std::ostream* out_, uint32_t wight_, uint32_t height_,
+            const std::string& rule = "B3/S23");
+  void Add(bool alive);
+  // Writes the end of the pattern; called by the destructor if needed.
+  void Finish();
+  ~RleWriter();
+
+ private:
+  RleWriter(const RleWriter&);
+  RleWriter& operator=(const RleWriter&);
+
+  void Put(uint64_t count, char tag);
+  // Writes the row ends that are still pending.
+  void FlushRows();
+  void EndRow();
+
+  std::ostream* out;
+  uint32_t wight;
+  uint32_t column;
+  uint64_t run;
+  bool run_alive;
+  uint64_t empty_rows;
+  size_t line;
+  bool finished;
+};
+
+// Writes live cells as Life 1.06 coordinates.
+class Life106Writer {
+ public:
+  explicit Life106Writer(std::ostream* out_);
+  void Add(int64_t x, int64_t y);
+
+ private:
+  std::ostream* out;
+};
+
+// The wight x height window of grid that starts at (x, y).
+template <class Grid>
+void WriteRle(std::ostream* out, const Grid& grid, int64_t x, int64_t y,
+              uint32_t wight, uint32_t height) {
+  RleWriter writer(out, wight, height);
+  for (uint32_t i = 0; i < height; ++i)
+    for (uint32_t j = 0; j < wight; ++j)
+      writer.Add(!(grid.GetCell(x + j, y + i) & 4));
+  writer.Finish();
+}
+
+template <class Grid>
+void WriteLife106(std::ostream* out, const Grid& grid, int64_t x, int64_t y,
+                  uint32_t wight, uint32_t height) {
+  Life106Writer writer(out);
+  for (uint32_t i = 0; i < height; ++i)
+    for (uint32_t j = 0; j < wight; ++j)
+      if (!(grid.GetCell(x + j, y + i) & 4))
+        writer.Add(j, i);
+}
+
+inline void WriteRle(std::ostream* out, const GameOfLifeGrid& grid) {
+  WriteRle(out, grid, 0, 0, grid.GetWight(), grid.GetHeight());
+}
+
+inline void WriteLife106(std::ostream* out, const GameOfLifeGrid& grid) {
+  WriteLife106(out, grid, 0, 0, grid.GetWight(), grid.GetHeight());
+}
+
+#endif  // MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_IO_H_
@@ -0,0 +1,22 @@
+// Copyright 2020 Kriukov Dmitry
+
+#ifndef MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_KERNEL_H_
+#define MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_KERNEL_H_
+
+#include <stdint.h>
+
+#include "include/game-of-life.h"
+
+// Writes the next state of the cells in rows [first_row, last_row) and
+// columns [first_col, last_col) of from into to; both are
+// (wight + 2) x (height + 2) buffers with a dead border. This is the kernel
+// of GameOfLifeGrid::Step, with its rule table and AVX2 path, for the grids
+// that only step a part of the cells.
+void StepBlock(const uchar* from, uchar* to, uint32_t wight,
+  uint32_t first_row, uint32_t last_row, uint32_t first_col,
+  uint32_t last_col, const LifeRule& rule);
+
+// The B3/S23 rule of the game of life.
+const LifeRule& ConwayRule();
+
+#endif  // MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_KERNEL_H_
@@ -0,0 +1,70 @@
+// Copyright 2020 Kriukov Dmitry
+
+#ifndef MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_PACKED_H_
+#define MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_PACKED_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+#include "include/game-of-life.h"
+
+// Next state of the 64 cells of a word by B3/S23. Every argument holds the
+// same 64 columns: nw, n, ne of the row above, w, center, e of the row itself
+// and sw, s, se of the row below, where w-words are shifted so that bit j
+// holds column j - 1 and e-words so that it holds column j + 1.
+inline uint64_t NextLifeWord(uint64_t nw, uint64_t n, uint64_t ne,
+                             uint64_t w, uint64_t center, uint64_t e,
+                             uint64_t sw, uint64_t s, uint64_t se) {
+  // Two-bit column sums of the rows above and below and of the side cells.
+  uint64_t above = nw ^ n ^ ne;
+  uint64_t above_carry = (nw & n) | (ne & (nw ^ n));
+  uint64_t below = sw ^ s ^ se;
+  uint64_t below_carry = (sw & s) | (se & (sw ^ s));
+  uint64_t side = w ^ e;
+  uint64_t side_carry = w & e;
+  // count = ones + 2 * twos + 4 * (any of the fours).
+  uint64_t ones = above ^ below ^ side;
+  uint64_t ones_carry = (above & below) | (side & (above ^ below));
+  uint64_t x = above_carry ^ below_carry;
+  uint64_t y = side_carry ^ ones_carry;
+  uint64_t twos = x ^ y;
+  uint64_t fours = (above_carry & below_carry) | (side_carry & ones_carry) |
+    (x & y);
+  return twos & ~fours & (ones | center);
+}
+
+// Game of life grid with 64 cells per machine word. A whole word of cells is
+// computed at once with bitwise adders, which is an order of magnitude faster
+// than GameOfLifeGrid. Cells outside the grid are dead, as in GameOfLifeGrid.
+class PackedLifeGrid {
+ public:
+  PackedLifeGrid() :wight(0), height(0), words(0) {}
+  PackedLifeGrid(uint32_t wight_, uint32_t height_);
+  explicit PackedLifeGrid(const GameOfLifeGrid& grid);
+  GameOfLifeGrid ToGrid() const;
+  uint32_t GetWight() const;
+  uint32_t GetHeight() const;
+  bool operator==(const PackedLifeGrid& grid) const;
+  bool operator!=(const PackedLifeGrid& grid) const;
+  void SetCell(uint32_t x, uint32_t y, uchar cell);
+  uchar GetCell(uint32_t x, uint32_t y) const;
+  uint64_t Population() const;
+  PackedLifeGrid NextGrid() const;
+  // Advances the grid in place; the second buffer is allocated only once.
+  void Step(uint32_t generations = 1);
+
+ private:
+  // Computes rows of to from rows of from; both have dead rows around.
+  void StepRows(const uint64_t* from, uint64_t* to,
+                uint32_t first_row, uint32_t last_row) const;
+
+  uint32_t wight;
+  uint32_t height;
+  size_t words;
+  // (height + 2) rows of words each, the first and the last one are dead.
+  std::vector<uint64_t> cells;
+  std::vector<uint64_t> next;
+};
+
+#endif  // MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_PACKED_H_
@@ -0,0 +1,36 @@
+// Copyright 2020 Kriukov Dmitry
+
+#ifndef MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_RULE_H_
+#define MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_RULE_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "include/game-of-life.h"
+
+// Life-like rule given by a string such as "B3/S23" (Conway's life),
+// "B36/S23" (HighLife) or the older survival/birth form "23/3". It is
+// compiled into a table of the next cell for all 512 neighbourhoods 3 x 3,
+// packed column by column from the left: bits 8..6 hold the left column,
+// 5..3 the middle one and 2..0 the right one, top to bottom in each.
+class LifeRule {
+ public:
+  static const uint32_t kTableSize = 512;
+
+  explicit LifeRule(const std::string& rule = "B3/S23");
+  bool operator==(const LifeRule& rule) const;
+  bool operator!=(const LifeRule& rule) const;
+  // Canonical form of the rule, "B36/S23".
+  std::string ToString() const;
+  bool Born(uint32_t neighbours) const;
+  bool Survives(uint32_t neighbours) const;
+  // aliveCell or deadCell for every packed neighbourhood.
+  const uchar* Table() const { return table; }
+
+ private:
+  uint32_t born;
+  uint32_t survives;
+  uchar table[kTableSize];
+};
+
+#endif  // MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_RULE_H_
@@ -0,0 +1,57 @@
+// Copyright 2020 Kriukov Dmitry
+
+#ifndef MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_SPARSE_H_
+#define MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_SPARSE_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <unordered_map>
+
+#include "include/game-of-life.h"
+
+// Unbounded game of life grid made of 64 x 64 chunks with one bit per cell,
+// kept in a hash map by chunk coordinates. Chunks are allocated when a cell
+// in them comes to life and freed when they become empty, so the memory is
+// proportional to the number of live chunks, not to the bounding box.
+class SparseLifeGrid {
+ public:
+  static const uint32_t kChunkSize = 64;
+
+  SparseLifeGrid() {}
+  // Places the cells of grid with its cell (0, 0) at (x, y).
+  explicit SparseLifeGrid(const GameOfLifeGrid& grid, int64_t x = 0,
+                          int64_t y = 0);
+  bool operator==(const SparseLifeGrid& grid) const;
+  bool operator!=(const SparseLifeGrid& grid) const;
+  void SetCell(int64_t x, int64_t y, uchar cell);
+  uchar GetCell(int64_t x, int64_t y) const;
+  // The wight x height window of the grid that starts at (x, y).
+  GameOfLifeGrid Export(int64_t x, int64_t y, uint32_t wight,
+                        uint32_t height) const;
+  uint64_t Population() const;
+  size_t ChunkCount() const;
+  SparseLifeGrid NextGrid() const;
+  void Step(uint32_t generations = 1);
+
+ private:
+  struct Chunk {
+    uint64_t rows[kChunkSize];
+  };
+  struct ChunkKey {
+    int64_t x;
+    int64_t y;
+    bool operator==(const ChunkKey& key) const;
+  };
+  struct ChunkKeyHash {
+    size_t operator()(const ChunkKey& key) const;
+  };
+  typedef std::unordered_map<ChunkKey, Chunk, ChunkKeyHash> ChunkMap;
+
+  const Chunk* Find(int64_t x, int64_t y) const;
+  // Next state of the chunk at key; returns false if it is empty.
+  bool StepChunk(const ChunkKey& key, Chunk* out) const;
+
+  ChunkMap chunks;
+};
+
+#endif  // MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_SPARSE_H_
@@ -0,0 +1,65 @@
+// Copyright 2020 Kriukov Dmitry
+
+#ifndef MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_TILED_H_
+#define MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_TILED_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "include/game-of-life.h"
+#include "include/game-of-life-rule.h"
+
+// Counters of the work done by TiledLifeGrid::Step.
+struct TileStats {
+  uint64_t tiles;         // tiles in the grid
+  uint64_t steps;         // generations computed so far
+  uint64_t last_active;   // tiles recomputed in the last generation
+  uint64_t total_active;  // tiles recomputed in all generations
+};
+
+// Game of life grid split into square tiles that remembers which tiles
+// changed in the last generation. A tile is recomputed only if it or one of
+// its eight neighbours changed, the rest are left as they are, so stable
+// and empty regions cost nothing. Both buffers hold the same cells in every
+// tile that did not change, which is why skipped tiles need no copying.
+// SetCell, Step and assignment keep the flags right when called through a
+// GameOfLifeGrid reference too. Tiles are computed on the calling thread,
+// threads_count is ignored.
+class TiledLifeGrid : public GameOfLifeGrid {
+ public:
+  TiledLifeGrid(uint32_t wight_, uint32_t height_, uint32_t tile_ = 32);
+  explicit TiledLifeGrid(const GameOfLifeGrid& grid, uint32_t tile_ = 32);
+  TiledLifeGrid& operator=(const TiledLifeGrid& grid);
+  uint32_t GetTileSize() const;
+  void SetCell(uint32_t x, uint32_t y, uchar cell) override;
+  // Advances the grid in place by the given number of generations, with
+  // the same kernel as GameOfLifeGrid::Step.
+  using GameOfLifeGrid::Step;
+  void Step(const LifeRule& rule, uint32_t generations = 1,
+            unsigned int threads_count = 1) override;
+  // Whether the tile with the given tile coordinates changed last step.
+  bool IsTileActive(uint32_t tile_x, uint32_t tile_y) const;
+  uint32_t ActiveTileCount() const;
+  TileStats GetStats() const;
+  void ResetStats();
+
+ protected:
+  void CellsReplaced() override;
+
+ private:
+  void MarkAll();
+  // Computes one tile into back; returns whether any cell has changed.
+  bool StepTile(uint32_t tile_x, uint32_t tile_y, const LifeRule& rule);
+
+  uint32_t tile;
+  uint32_t tiles_x;
+  uint32_t tiles_y;
+  // One flag per tile: the tile changed in the last generation.
+  std::vector<uchar> changed;
+  std::vector<uchar> next_changed;
+  // The rule of the last Step; the flags are only valid for it.
+  LifeRule last_rule;
+  TileStats stats;
+};
+
+#endif  // MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_TILED_H_
@@ -10,27 +10,51 @@ extern const unsigned char deadCell;
 #include<stdint.h>
 #include <new>
 
+class LifeRule;
+
 class GameOfLifeGrid {
  public:
-  GameOfLifeGrid() :wight(0), height(0), node(nullptr) {}
+  GameOfLifeGrid() :wight(0), height(0), node(nullptr), back(nullptr) {}
   GameOfLifeGrid(uint32_t wight_, uint32_t height_);
   GameOfLifeGrid(uint32_t wight_, uint32_t height_, uchar* input);
   GameOfLifeGrid(const GameOfLifeGrid& grid);
-  ~GameOfLifeGrid();
-  uint32_t GetWight();
-  uint32_t GetHeight();
+  virtual ~GameOfLifeGrid();
+  uint32_t GetWight() const;
+  uint32_t GetHeight() const;
   bool operator==(const GameOfLifeGrid& grid) const;
   bool operator!=(const GameOfLifeGrid& grid);
   GameOfLifeGrid& operator=(const GameOfLifeGrid&);
-  uchar NextCondition(uint32_t x, uint32_t y);
-  uchar NeighborCount(uint32_t x, uint32_t y);
-  void SetCell(uint32_t x, uint32_t y, uchar cell);
-  uchar GetCell(uint32_t x, uint32_t y);
-  GameOfLifeGrid NextGrid();
+  uchar NextCondition(uint32_t x, uint32_t y) const;
+  uchar NeighborCount(uint32_t x, uint32_t y) const;
+  virtual void SetCell(uint32_t x, uint32_t y, uchar cell);
+  uchar GetCell(uint32_t x, uint32_t y) const;
+  GameOfLifeGrid NextGrid() const;
+  // Next generation by any life-like rule, see game-of-life-rule.h.
+  GameOfLifeGrid NextGrid(const LifeRule& rule) const;
+  // Advances the grid in place by swapping node with a second buffer that
+  // is allocated on the first call only. Rows are split into bands between
+  // threads_count threads (0 - all cores), which stay alive for all the
+  // generations of one call.
+  // Derived grids that keep their own state about the cells override
+  // SetCell, the rule Step and CellsReplaced.
+  void Step(uint32_t generations = 1, unsigned int threads_count = 1);
+  virtual void Step(const LifeRule& rule, uint32_t generations = 1,
+            unsigned int threads_count = 1);
+  // NextGrid and Step compute 32 cells at a time with AVX2 when the CPU has
+  // it; the result is the same byte for byte. EnableSimd(false) makes every
+  // grid use the scalar code, EnableSimd(true) turns AVX2 back on if it is
+  // supported.
+  static bool SimdSupported();
+  static void EnableSimd(bool enable);
+
  protected:
+  // Called by operator= after all the cells have been overwritten.
+  virtual void CellsReplaced() {}
+
   uint32_t wight;
   uint32_t height;
   uchar* node;
+  uchar* back;
 };
 
 #endif  // MODULES_GAME_OF_LIFE_INCLUDE_GAME_OF_LIFE_H_
@@ -0,0 +1,356 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "include/game-of-life-hashlife.h"
+
+#define ISALIVE(arg) (!((arg) & 4))
+
+namespace {
+
+// Coordinates of a root node must fit into int64_t.
+const uint32_t kMaxLevel = 62;
+// The root is never smaller than 8x8, the least size that Step can advance.
+const uint32_t kMinRootLevel = 3;
+
+}  // namespace
+
+struct HashLifeUniverse::Node {
+  Node* nw;
+  Node* ne;
+  Node* sw;
+  Node* se;
+  // The centre half advanced by 2^result_log generations, if known.
+  Node* result;
+  uint32_t level;
+  uint32_t result_log;
+  uint64_t population;
+  bool marked;
+};
+
+bool HashLifeUniverse::NodeKey::operator==(const NodeKey& key) const {
+  return std::equal(quadrants, quadrants + 4, key.quadrants);
+}
+
+size_t HashLifeUniverse::NodeKeyHash::operator()(const NodeKey& key) const {
+  size_t hash = 0;
+  for (int i = 0; i < 4; ++i)
+    hash = hash * 1000003 ^ reinterpret_cast<uintptr_t>(key.quadrants[i]);
+  return hash ^ (hash >> 17);
+}
+
+HashLifeUniverse::HashLifeUniverse(size_t max_nodes_)
+  :dead(new Node()), alive(new Node()), root(nullptr), step_log(0),
+  generation(0), max_nodes(max_nodes_), collect_at(max_nodes_) {
+  alive->population = 1;
+  empty.push_back(dead);
+  root = Empty(kMinRootLevel);
+}
+
+HashLifeUniverse::~HashLifeUniverse() {
+  for (auto it = nodes.begin(); it != nodes.end(); ++it)
+    delete it->second;
+  delete dead;
+  delete alive;
+}
+
+HashLifeUniverse::Node* HashLifeUniverse::Join(Node* nw, Node* ne, Node* sw,
+                                               Node* se) {
+  NodeKey key = { { nw, ne, sw, se } };
+  auto found = nodes.find(key);
+  if (found != nodes.end())
+    return found->second;
+  if (nodes.size() >= collect_at) {
+    Node* const quadrants[4] = { nw, ne, sw, se };
+    pinned.insert(pinned.end(), quadrants, quadrants + 4);
+    CollectGarbage();
+    pinned.resize(pinned.size() - 4);
+  }
+  Node* node = new Node();
+  node->nw = nw;
+  node->ne = ne;
+  node->sw = sw;
+  node->se = se;
+  node->level = nw->level + 1;
+  node->population =
+    nw->population + ne->population + sw->population + se->population;
+  nodes[key] = node;
+  return node;
+}
+
+HashLifeUniverse::Node* HashLifeUniverse::Pin(Node* node) {
+  pinned.push_back(node);
+  return node;
+}
+
+HashLifeUniverse::Node* HashLifeUniverse::Empty(uint32_t level) {
+  while (empty.size() <= level) {
+    Node* e = empty.back();
+    empty.push_back(Join(e, e, e, e));
+  }
+  return empty[level];
+}
+
+HashLifeUniverse::Node* HashLifeUniverse::Expand(Node* node) {
+  if (node->level >= kMaxLevel)
+    throw "universe is too large";
+  size_t pins = pinned.size();
+  Pin(node);
+  Node* e = Empty(node->level - 1);
+  Node* nw = Pin(Join(e, e, e, node->nw));
+  Node* ne = Pin(Join(e, e, node->ne, e));
+  Node* sw = Pin(Join(e, node->sw, e, e));
+  Node* se = Join(node->se, e, e, e);
+  Node* result = Join(nw, ne, sw, se);
+  pinned.resize(pins);
+  return result;
+}
+
+HashLifeUniverse::Node* HashLifeUniverse::Center(Node* node) {
+  return Join(node->nw->se, node->ne->sw, node->sw->ne, node->se->nw);
+}
+
+HashLifeUniverse::Node* HashLifeUniverse::BaseResult(Node* node) {
+  // Cells of the 4x4 node, row by row.
+  bool cells[4][4];
+  Node* quadrants[2][2] = { { node->nw, node->ne }, { node->sw, node->se } };
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 4; ++x) {
+      Node* q = quadrants[y / 2][x / 2];
+      Node* leafs[2][2] = { { q->nw, q->ne }, { q->sw, q->se } };
+      cells[y][x] = leafs[y % 2][x % 2]->population != 0;
+    }
+  }
+  Node* next[2][2];
+  for (int y = 1; y < 3; ++y) {
+    for (int x = 1; x < 3; ++x) {
+      int ncount = 0;
+      for (int dy = -1; dy <= 1; ++dy)
+        for (int dx = -1; dx <= 1; ++dx)
+          ncount += (dx != 0 || dy != 0) && cells[y + dy][x + dx];
+      next[y - 1][x - 1] =
+        ncount == 3 || (ncount == 2 && cells[y][x]) ? alive : dead;
+    }
+  }
+  return Join(next[0][0], next[0][1], next[1][0], next[1][1]);
+}
+
+HashLifeUniverse::Node* HashLifeUniverse::Result(Node* node) {
+  uint32_t log = std::min(step_log, node->level - 2);
+  if (node->result != nullptr && node->result_log == log)
+    return node->result;
+
+  // Every node made below is pinned until the result is joined, as any
+  // Join may collect garbage.
+  size_t pins = pinned.size();
+  Pin(node);
+  Node* result;
+  if (node->population == 0) {
+    result = Empty(node->level - 1);
+  } else if (node->level == 2) {
+    result = BaseResult(node);
+  } else {
+    // Nine overlapping subnodes of half the size.
+    Node* n[3][3] = {
+      { node->nw, Pin(Join(node->nw->ne, node->ne->nw, node->nw->se,
+                           node->ne->sw)), node->ne },
+      { Pin(Join(node->nw->sw, node->nw->se, node->sw->nw, node->sw->ne)),
+        Pin(Center(node)),
+        Pin(Join(node->ne->sw, node->ne->se, node->se->nw, node->se->ne)) },
+      { node->sw, Pin(Join(node->sw->ne, node->se->nw, node->sw->se,
+                           node->se->sw)), node->se } };
+    // At full speed both halves of the time are advanced; otherwise the
+    // first half only takes the centres and the second one does all.
+    bool full_speed = log == node->level - 2;
+    Node* r[3][3];
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        r[i][j] = Pin(full_speed ? Result(n[i][j]) : Center(n[i][j]));
+    Node* nw = Pin(Result(Pin(Join(r[0][0], r[0][1], r[1][0], r[1][1]))));
+    Node* ne = Pin(Result(Pin(Join(r[0][1], r[0][2], r[1][1], r[1][2]))));
+    Node* sw = Pin(Result(Pin(Join(r[1][0], r[1][1], r[2][0], r[2][1]))));
+    Node* se = Result(Join(r[1][1], r[1][2], r[2][1], r[2][2]));
+    result = Join(nw, ne, sw, se);
+  }
+  pinned.resize(pins);
+  node->result = result;
+  node->result_log = log;
+  return result;
+}
+
+HashLifeUniverse::Node* HashLifeUniverse::Set(Node* node, uint64_t x,
+                                              uint64_t y, bool is_alive) {
+  if (node->level == 0)
+    return is_alive ? alive : dead;
+  uint64_t half = uint64_t(1) << (node->level - 1);
+  Node* nw = node->nw;
+  Node* ne = node->ne;
+  Node* sw = node->sw;
+  Node* se = node->se;
+  if (y < half) {
+    if (x < half)
+      nw = Set(nw, x, y, is_alive);
+    else
+      ne = Set(ne, x - half, y, is_alive);
+  } else {
+    if (x < half)
+      sw = Set(sw, x, y - half, is_alive);
+    else
+      se = Set(se, x - half, y - half, is_alive);
+  }
+  return Join(nw, ne, sw, se);
+}
+
+bool HashLifeUniverse::Contains(int64_t x, int64_t y) const {
+  int64_t half = int64_t(1) << (root->level - 1);
+  return x >= -half && x < half && y >= -half && y < half;
+}
+
+void HashLifeUniverse::SetCell(int64_t x, int64_t y, uchar cell) {
+  while (!Contains(x, y))
+    root = Expand(root);
+  int64_t half = int64_t(1) << (root->level - 1);
+  root = Set(root, static_cast<uint64_t>(x + half),
+             static_cast<uint64_t>(y + half), ISALIVE(cell));
+}
+
+uchar HashLifeUniverse::GetCell(int64_t x, int64_t y) const {
+  if (!Contains(x, y))
+    return deadCell;
+  int64_t half = int64_t(1) << (root->level - 1);
+  uint64_t ux = static_cast<uint64_t>(x + half);
+  uint64_t uy = static_cast<uint64_t>(y + half);
+  const Node* node = root;
+  while (node->level > 0 && node->population != 0) {
+    uint64_t quarter = uint64_t(1) << (node->level - 1);
+    if (uy < quarter)
+      node = ux < quarter ? node->nw : node->ne;
+    else
+      node = ux < quarter ? node->sw : node->se;
+    ux %= quarter;
+    uy %= quarter;
+  }
+  return node->population != 0 ? aliveCell : deadCell;
+}
+
+void HashLifeUniverse::Import(const GameOfLifeGrid& grid, int64_t x,
+                              int64_t y) {
+  for (uint32_t j = 0; j < grid.GetHeight(); ++j)
+    for (uint32_t i = 0; i < grid.GetWight(); ++i)
+      if (ISALIVE(grid.GetCell(i, j)))
+        SetCell(x + i, y + j, aliveCell);
+}
+
+GameOfLifeGrid HashLifeUniverse::Export(int64_t x, int64_t y, uint32_t wight,
+                                        uint32_t height) const {
+  GameOfLifeGrid grid(wight, height);
+  int64_t half = int64_t(1) << (root->level - 1);
+  ExportNode(root, -half, -half, x, y, &grid);
+  return grid;
+}
+
+void HashLifeUniverse::ExportNode(const Node* node, int64_t left, int64_t top,
+                                  int64_t x, int64_t y,
+                                  GameOfLifeGrid* grid) const {
+  int64_t size = int64_t(1) << node->level;
+  if (node->population == 0 || left >= x + grid->GetWight() ||
+      top >= y + grid->GetHeight() || left + size <= x || top + size <= y)
+    return;
+  if (node->level == 0) {
+    grid->SetCell(static_cast<uint32_t>(left - x),
+                  static_cast<uint32_t>(top - y), aliveCell);
+    return;
+  }
+  int64_t half = size / 2;
+  ExportNode(node->nw, left, top, x, y, grid);
+  ExportNode(node->ne, left + half, top, x, y, grid);
+  ExportNode(node->sw, left, top + half, x, y, grid);
+  ExportNode(node->se, left + half, top + half, x, y, grid);
+}
+
+void HashLifeUniverse::SetStep(uint32_t step_log_) {
+  if (step_log_ + kMinRootLevel > kMaxLevel)
+    throw "step is too large";
+  step_log = step_log_;
+}
+
+uint32_t HashLifeUniverse::GetStep() const {
+  return step_log;
+}
+
+void HashLifeUniverse::Step() {
+  if (nodes.size() > max_nodes)
+    CollectGarbage();
+  // The pattern must stay inside the centre quarter, so that it cannot
+  // leave the centre half that Result returns.
+  while (root->level < step_log + kMinRootLevel ||
+         root->nw->se->se->population + root->ne->sw->sw->population +
+         root->sw->ne->ne->population + root->se->nw->nw->population !=
+         root->population)
+    root = Expand(root);
+  root = Result(root);
+  generation += uint64_t(1) << step_log;
+}
+
+void HashLifeUniverse::Run(uint64_t generations) {
+  uint32_t old_step_log = step_log;
+  for (uint32_t bit = 64; bit-- > 0;) {
+    if ((generations >> bit) & 1) {
+      SetStep(bit);
+      Step();
+    }
+  }
+  step_log = old_step_log;
+}
+
+uint64_t HashLifeUniverse::Generation() const {
+  return generation;
+}
+
+uint64_t HashLifeUniverse::Population() const {
+  return root->population;
+}
+
+size_t HashLifeUniverse::NodeCount() const {
+  return nodes.size();
+}
+
+void HashLifeUniverse::Mark(Node* node) {
+  if (node->marked || node->level == 0)
+    return;
+  node->marked = true;
+  Mark(node->nw);
+  Mark(node->ne);
+  Mark(node->sw);
+  Mark(node->se);
+}
+
+void HashLifeUniverse::CollectGarbage() {
+  Mark(root);
+  for (size_t level = 1; level < empty.size(); ++level)
+    Mark(empty[level]);
+  for (size_t i = 0; i < pinned.size(); ++i)
+    Mark(pinned[i]);
+  // Results are only a cache: the ones that point to freed nodes are
+  // forgotten first, then the unreachable nodes are freed.
+  for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+    Node* node = it->second;
+    if (node->marked && node->result != nullptr &&
+        node->result->level > 0 && !node->result->marked)
+      node->result = nullptr;
+  }
+  for (auto it = nodes.begin(); it != nodes.end();) {
+    if (it->second->marked) {
+      it->second->marked = false;
+      ++it;
+    } else {
+      delete it->second;
+      it = nodes.erase(it);
+    }
+  }
+  // Collecting again before the cache has doubled over what is in use
+  // would cost more than it frees.
+  collect_at = std::max(max_nodes, 2 * nodes.size());
+}
@@ -0,0 +1,396 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "include/game-of-life-io.h"
+
+namespace {
+
+const uint64_t kMaxCount = uint64_t(1) << 62;
+const size_t kMaxLine = 70;
+const char kLife106Header[] = "#Life 1.06";
+
+// Read-only mapping of a whole pattern file.
+class PatternFile {
+ public:
+  explicit PatternFile(const std::string& path);
+  ~PatternFile();
+  const char* Data() const { return data; }
+  size_t Size() const { return size; }
+
+ private:
+  PatternFile(const PatternFile&);
+  PatternFile& operator=(const PatternFile&);
+
+  const char* data;
+  size_t size;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+};
+
+#ifdef _WIN32
+PatternFile::PatternFile(const std::string& path)
+  :data(nullptr), size(0), file(INVALID_HANDLE_VALUE), mapping(nullptr) {
+  file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                     OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    throw "cannot open pattern file";
+  LARGE_INTEGER bytes;
+  GetFileSizeEx(file, &bytes);
+  size = static_cast<size_t>(bytes.QuadPart);
+  if (size == 0)
+    return;
+  mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+                       : nullptr;
+  if (view == nullptr) {
+    if (mapping)
+      CloseHandle(mapping);
+    CloseHandle(file);
+    throw "cannot map pattern file";
+  }
+  data = static_cast<const char*>(view);
+}
+
+PatternFile::~PatternFile() {
+  if (data)
+    UnmapViewOfFile(data);
+  if (mapping)
+    CloseHandle(mapping);
+  CloseHandle(file);
+}
+#else
+PatternFile::PatternFile(const std::string& path) :data(nullptr), size(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw "cannot open pattern file";
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw "cannot open pattern file";
+  }
+  size = static_cast<size_t>(info.st_size);
+  if (size != 0) {
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+      close(fd);
+      throw "cannot map pattern file";
+    }
+    madvise(view, size, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(view);
+  }
+  close(fd);
+}
+
+PatternFile::~PatternFile() {
+  if (data)
+    munmap(const_cast<char*>(data), size);
+}
+#endif
+
+// Counts the live cells and nothing else.
+class NullSink : public PatternSink {
+ public:
+  void Alive(int64_t, int64_t) {}
+};
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool IsLetter(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+const char* SkipLine(const char* p, const char* end) {
+  while (p < end && *p != '\n')
+    ++p;
+  return p;
+}
+
+std::string Trim(const std::string& text) {
+  size_t first = 0;
+  size_t last = text.size();
+  while (first < last && IsSpace(text[first]))
+    ++first;
+  while (last > first && IsSpace(text[last - 1]))
+    --last;
+  return text.substr(first, last - first);
+}
+
+int64_t ToSize(const std::string& value) {
+  if (value.empty())
+    throw "bad RLE header";
+  for (size_t i = 0; i < value.size(); ++i)
+    if (!IsDigit(value[i]))
+      throw "bad RLE header";
+  return std::strtoll(value.c_str(), nullptr, 10);
+}
+
+// "x = 3, y = 3, rule = B3/S23"
+void ReadRleHeader(const std::string& line, PatternInfo* info) {
+  size_t start = 0;
+  while (start < line.size()) {
+    size_t comma = line.find(',', start);
+    if (comma == std::string::npos)
+      comma = line.size();
+    std::string item = line.substr(start, comma - start);
+    size_t equal = item.find('=');
+    if (equal == std::string::npos)
+      throw "bad RLE header";
+    std::string key = Trim(item.substr(0, equal));
+    std::string value = Trim(item.substr(equal + 1));
+    if (key == "x")
+      info->wight = ToSize(value);
+    else if (key == "y")
+      info->height = ToSize(value);
+    else if (key == "rule")
+      info->rule = value;
+    start = comma + 1;
+  }
+}
+
+bool ReadInt(const char** cursor, const char* end, int64_t* value) {
+  const char* p = *cursor;
+  while (p < end && (*p == ' ' || *p == '\t'))
+    ++p;
+  bool negative = p < end && *p == '-';
+  if (p < end && (*p == '-' || *p == '+'))
+    ++p;
+  if (p == end || !IsDigit(*p))
+    return false;
+  uint64_t result = 0;
+  for (; p < end && IsDigit(*p); ++p) {
+    result = result * 10 + (*p - '0');
+    if (result > kMaxCount)
+      return false;
+  }
+  *value = negative ? -static_cast<int64_t>(result) :
+    static_cast<int64_t>(result);
+  *cursor = p;
+  return true;
+}
+
+PatternInfo EmptyInfo() {
+  PatternInfo info;
+  info.left = 0;
+  info.top = 0;
+  info.wight = 0;
+  info.height = 0;
+  info.population = 0;
+  info.rule = "B3/S23";
+  return info;
+}
+
+}  // namespace
+
+PatternInfo ReadRle(const char* data, size_t size, PatternSink* sink) {
+  PatternInfo info = EmptyInfo();
+  const char* p = data;
+  const char* end = data + size;
+  while (p < end && (IsSpace(*p) || *p == '#'))
+    p = *p == '#' ? SkipLine(p, end) : p + 1;
+  bool has_header = p < end && *p == 'x';
+  if (has_header) {
+    const char* line_end = SkipLine(p, end);
+    ReadRleHeader(std::string(p, line_end), &info);
+    p = line_end;
+  }
+
+  int64_t x = 0;
+  int64_t y = 0;
+  int64_t right = 0;
+  uint64_t count = 0;
+  bool ended = false;
+  for (; p < end && !ended; ++p) {
+    char c = *p;
+    if (IsDigit(c)) {
+      count = count * 10 + (c - '0');
+      if (count > kMaxCount)
+        throw "bad RLE pattern";
+      continue;
+    }
+    if (IsSpace(c))
+      continue;
+    if (c == '#') {
+      p = SkipLine(p, end) - 1;
+      continue;
+    }
+    int64_t n = count == 0 ? 1 : static_cast<int64_t>(count);
+    count = 0;
+    if (c == '!') {
+      ended = true;
+    } else if (c == '$') {
+      y += n;
+      x = 0;
+    } else if (c == 'b' || c == '.') {
+      x += n;
+    } else if (IsLetter(c)) {
+      for (int64_t k = 0; k < n; ++k)
+        sink->Alive(x + k, y);
+      x += n;
+      info.population += n;
+      right = std::max(right, x);
+      info.height = has_header ? info.height : std::max(info.height, y + 1);
+    } else {
+      throw "bad RLE pattern";
+    }
+  }
+  if (!has_header)
+    info.wight = right;
+  return info;
+}
+
+PatternInfo ReadLife106(const char* data, size_t size, PatternSink* sink) {
+  PatternInfo info = EmptyInfo();
+  int64_t right = 0;
+  int64_t bottom = 0;
+  const char* p = data;
+  const char* end = data + size;
+  while (p < end) {
+    if (IsSpace(*p)) {
+      ++p;
+      continue;
+    }
+    if (*p == '#') {
+      p = SkipLine(p, end);
+      continue;
+    }
+    int64_t x, y;
+    if (!ReadInt(&p, end, &x) || !ReadInt(&p, end, &y))
+      throw "bad Life 1.06 pattern";
+    while (p < end && *p != '\n')
+      if (!IsSpace(*p++))
+        throw "bad Life 1.06 pattern";
+    if (info.population == 0) {
+      info.left = right = x;
+      info.top = bottom = y;
+    }
+    info.left = std::min(info.left, x);
+    info.top = std::min(info.top, y);
+    right = std::max(right, x);
+    bottom = std::max(bottom, y);
+    ++info.population;
+    sink->Alive(x, y);
+  }
+  if (info.population != 0) {
+    info.wight = right - info.left + 1;
+    info.height = bottom - info.top + 1;
+  }
+  return info;
+}
+
+PatternInfo ReadPattern(const char* data, size_t size, PatternSink* sink) {
+  const size_t header = sizeof(kLife106Header) - 1;
+  if (size >= header && std::equal(data, data + header, kLife106Header))
+    return ReadLife106(data, size, sink);
+  return ReadRle(data, size, sink);
+}
+
+PatternInfo LoadPattern(const std::string& path, PatternSink* sink) {
+  PatternFile file(path);
+  return ReadPattern(file.Data(), file.Size(), sink);
+}
+
+GameOfLifeGrid LoadGrid(const std::string& path) {
+  PatternFile file(path);
+  NullSink bounds;
+  PatternInfo info = ReadPattern(file.Data(), file.Size(), &bounds);
+  // GameOfLifeGrid indexes its bordered buffer with uint32_t arithmetic.
+  if (info.wight > UINT32_MAX - 2 || info.height > UINT32_MAX - 2 ||
+      static_cast<uint64_t>(info.wight + 2) *
+      static_cast<uint64_t>(info.height + 2) > UINT32_MAX)
+    throw "pattern is too big for a dense grid";
+  GameOfLifeGrid grid(static_cast<uint32_t>(info.wight),
+                      static_cast<uint32_t>(info.height));
+  GridSink<GameOfLifeGrid> sink(&grid, -info.left, -info.top);
+  ReadPattern(file.Data(), file.Size(), &sink);
+  return grid;
+}
+
+RleWriter::RleWriter(std::ostream* out_, uint32_t wight_, uint32_t height_,
+  const std::string& rule) :out(out_), wight(wight_), column(0), run(0),
+  run_alive(false), empty_rows(0), line(0), finished(false) {
+  *out << "x = " << wight << ", y = " << height_ << ", rule = " << rule
+    << '\n';
+}
+
+RleWriter::~RleWriter() {
+  if (!finished)
+    Finish();
+}
+
+void RleWriter::Put(uint64_t count, char tag) {
+  std::string token = count > 1 ? std::to_string(count) : std::string();
+  token += tag;
+  if (line + token.size() > kMaxLine) {
+    *out << '\n';
+    line = 0;
+  }
+  *out << token;
+  line += token.size();
+}
+
+void RleWriter::FlushRows() {
+  if (empty_rows != 0)
+    Put(empty_rows, '$');
+  empty_rows = 0;
+}
+
+void RleWriter::Add(bool alive) {
+  if (run != 0 && alive != run_alive) {
+    FlushRows();
+    Put(run, run_alive ? 'o' : 'b');
+    run = 0;
+  }
+  run_alive = alive;
+  ++run;
+  if (++column == wight)
+    EndRow();
+}
+
+void RleWriter::EndRow() {
+  if (run_alive && run != 0) {
+    FlushRows();
+    Put(run, 'o');
+  }
+  run = 0;
+  column = 0;
+  ++empty_rows;
+}
+
+void RleWriter::Finish() {
+  if (run_alive && run != 0) {
+    FlushRows();
+    Put(run, 'o');
+    run = 0;
+  }
+  Put(1, '!');
+  *out << '\n';
+  finished = true;
+}
+
+Life106Writer::Life106Writer(std::ostream* out_) :out(out_) {
+  *out << kLife106Header << '\n';
+}
+
+void Life106Writer::Add(int64_t x, int64_t y) {
+  *out << x << ' ' << y << '\n';
+}
@@ -0,0 +1,129 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <bitset>
+#include <vector>
+
+#include "include/game-of-life-packed.h"
+
+#define ISALIVE(arg) (!((arg) & 4))
+
+namespace {
+
+const uint32_t kWordBits = 64;
+
+size_t WordsPerRow(uint32_t wight) {
+  return (wight + kWordBits - 1) / kWordBits;
+}
+
+// Columns of the last word that are inside the grid.
+uint64_t TailMask(uint32_t wight) {
+  uint32_t tail = wight % kWordBits;
+  return tail == 0 ? ~uint64_t(0) : (uint64_t(1) << tail) - 1;
+}
+
+}  // namespace
+
+PackedLifeGrid::PackedLifeGrid(uint32_t wight_, uint32_t height_)
+  :wight(wight_), height(height_), words(WordsPerRow(wight_)),
+  cells(words * (height_ + 2), 0) {}
+
+PackedLifeGrid::PackedLifeGrid(const GameOfLifeGrid& grid)
+  :wight(grid.GetWight()), height(grid.GetHeight()),
+  words(WordsPerRow(wight)), cells(words * (height + 2), 0) {
+  for (uint32_t y = 0; y < height; ++y)
+    for (uint32_t x = 0; x < wight; ++x)
+      if (ISALIVE(grid.GetCell(x, y)))
+        cells[(y + 1) * words + x / kWordBits] |=
+          uint64_t(1) << (x % kWordBits);
+}
+
+GameOfLifeGrid PackedLifeGrid::ToGrid() const {
+  GameOfLifeGrid grid(wight, height);
+  for (uint32_t y = 0; y < height; ++y)
+    for (uint32_t x = 0; x < wight; ++x)
+      if ((cells[(y + 1) * words + x / kWordBits] >> (x % kWordBits)) & 1)
+        grid.SetCell(x, y, aliveCell);
+  return grid;
+}
+
+uint32_t PackedLifeGrid::GetWight() const {
+  return wight;
+}
+
+uint32_t PackedLifeGrid::GetHeight() const {
+  return height;
+}
+
+bool PackedLifeGrid::operator==(const PackedLifeGrid& grid) const {
+  return wight == grid.wight && height == grid.height && cells == grid.cells;
+}
+
+bool PackedLifeGrid::operator!=(const PackedLifeGrid& grid) const {
+  return !(*this == grid);
+}
+
+void PackedLifeGrid::SetCell(uint32_t x, uint32_t y, uchar cell) {
+  if ((x >= wight) || (y >= height))
+    throw "index is out of the grid";
+  uint64_t bit = uint64_t(1) << (x % kWordBits);
+  uint64_t& word = cells[(y + 1) * words + x / kWordBits];
+  word = ISALIVE(cell) ? (word | bit) : (word & ~bit);
+}
+
+uchar PackedLifeGrid::GetCell(uint32_t x, uint32_t y) const {
+  if ((x >= wight) || (y >= height))
+    throw "index is out of the grid";
+  return (cells[(y + 1) * words + x / kWordBits] >> (x % kWordBits)) & 1 ?
+    aliveCell : deadCell;
+}
+
+uint64_t PackedLifeGrid::Population() const {
+  uint64_t population = 0;
+  for (size_t i = 0; i < cells.size(); ++i)
+    population += std::bitset<kWordBits>(cells[i]).count();
+  return population;
+}
+
+PackedLifeGrid PackedLifeGrid::NextGrid() const {
+  PackedLifeGrid res(wight, height);
+  if (words == 0 || height == 0)
+    return res;
+  StepRows(cells.data(), res.cells.data(), 0, height);
+  return res;
+}
+
+void PackedLifeGrid::Step(uint32_t generations) {
+  if (words == 0 || height == 0)
+    return;
+  next.resize(cells.size(), 0);
+  for (uint32_t i = 0; i < generations; ++i) {
+    StepRows(cells.data(), next.data(), 0, height);
+    cells.swap(next);
+  }
+}
+
+void PackedLifeGrid::StepRows(const uint64_t* from, uint64_t* to,
+                              uint32_t first_row, uint32_t last_row) const {
+  const uint64_t tail_mask = TailMask(wight);
+  const size_t last = words - 1;
+  for (uint32_t y = first_row; y < last_row; ++y) {
+    const uint64_t* above = from + y * words;
+    const uint64_t* row = above + words;
+    const uint64_t* below = row + words;
+    uint64_t* out = to + (y + 1) * words;
+    for (size_t k = 0; k < words; ++k) {
+      // Carries from the neighbouring words; zero past the grid edges.
+      uint64_t above_prev = k > 0 ? above[k - 1] >> 63 : 0;
+      uint64_t row_prev = k > 0 ? row[k - 1] >> 63 : 0;
+      uint64_t below_prev = k > 0 ? below[k - 1] >> 63 : 0;
+      uint64_t above_next = k < last ? above[k + 1] << 63 : 0;
+      uint64_t row_next = k < last ? row[k + 1] << 63 : 0;
+      uint64_t below_next = k < last ? below[k + 1] << 63 : 0;
+      out[k] = NextLifeWord(
+        (above[k] << 1) | above_prev, above[k], (above[k] >> 1) | above_next,
+        (row[k] << 1) | row_prev, row[k], (row[k] >> 1) | row_next,
+        (below[k] << 1) | below_prev, below[k], (below[k] >> 1) | below_next);
+    }
+    out[last] &= tail_mask;
+  }
+}
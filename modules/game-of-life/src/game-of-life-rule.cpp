@@ -0,0 +1,89 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <bitset>
+#include <string>
+
+#include "include/game-of-life-rule.h"
+
+namespace {
+
+const uint32_t kCenterBit = 1 << 4;
+
+// Digits 0..8 of text as a bit mask.
+uint32_t ParseCounts(const std::string& text) {
+  uint32_t mask = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    if (text[i] < '0' || text[i] > '8')
+      throw "bad rule string";
+    mask |= 1u << (text[i] - '0');
+  }
+  return mask;
+}
+
+std::string CountsToString(uint32_t mask) {
+  std::string text;
+  for (char n = 0; n <= 8; ++n)
+    if (mask & (1u << n))
+      text += static_cast<char>('0' + n);
+  return text;
+}
+
+}  // namespace
+
+const uint32_t LifeRule::kTableSize;
+
+LifeRule::LifeRule(const std::string& rule) :born(0), survives(0) {
+  size_t slash = rule.find('/');
+  if (slash == std::string::npos || rule.find('/', slash + 1) !=
+      std::string::npos)
+    throw "bad rule string";
+  std::string parts[2] = { rule.substr(0, slash), rule.substr(slash + 1) };
+  int lettered = 0;
+  uint32_t seen = 0;
+  for (int k = 0; k < 2; ++k) {
+    const std::string& part = parts[k];
+    char tag = part.empty() ? 0 : part[0];
+    if (tag == 'B' || tag == 'b') {
+      born = ParseCounts(part.substr(1));
+      seen |= 1;
+      ++lettered;
+    } else if (tag == 'S' || tag == 's') {
+      survives = ParseCounts(part.substr(1));
+      seen |= 2;
+      ++lettered;
+    }
+  }
+  if (lettered == 0) {
+    survives = ParseCounts(parts[0]);
+    born = ParseCounts(parts[1]);
+  } else if (seen != 3) {
+    throw "bad rule string";
+  }
+  for (uint32_t index = 0; index < kTableSize; ++index) {
+    bool center = (index & kCenterBit) != 0;
+    uint32_t neighbours =
+      static_cast<uint32_t>(std::bitset<9>(index & ~kCenterBit).count());
+    bool alive = center ? Survives(neighbours) : Born(neighbours);
+    table[index] = alive ? aliveCell : deadCell;
+  }
+}
+
+bool LifeRule::operator==(const LifeRule& rule) const {
+  return born == rule.born && survives == rule.survives;
+}
+
+bool LifeRule::operator!=(const LifeRule& rule) const {
+  return !(*this == rule);
+}
+
+std::string LifeRule::ToString() const {
+  return "B" + CountsToString(born) + "/S" + CountsToString(survives);
+}
+
+bool LifeRule::Born(uint32_t neighbours) const {
+  return neighbours <= 8 && (born >> neighbours) & 1;
+}
+
+bool LifeRule::Survives(uint32_t neighbours) const {
+  return neighbours <= 8 && (survives >> neighbours) & 1;
+}
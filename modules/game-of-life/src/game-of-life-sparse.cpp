@@ -0,0 +1,214 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <bitset>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "include/game-of-life-packed.h"
+#include "include/game-of-life-sparse.h"
+
+#define ISALIVE(arg) (!((arg) & 4))
+
+namespace {
+
+const int64_t kChunk = SparseLifeGrid::kChunkSize;
+const uint64_t kHighBit = uint64_t(1) << 63;
+
+// Rounds towards minus infinity, so that cell -1 is in chunk -1.
+int64_t ChunkOf(int64_t coord) {
+  return coord >= 0 ? coord / kChunk : -((-(coord + 1)) / kChunk) - 1;
+}
+
+uint32_t OffsetOf(int64_t coord) {
+  return static_cast<uint32_t>(coord - ChunkOf(coord) * kChunk);
+}
+
+}  // namespace
+
+const uint32_t SparseLifeGrid::kChunkSize;
+
+bool SparseLifeGrid::ChunkKey::operator==(const ChunkKey& key) const {
+  return x == key.x && y == key.y;
+}
+
+size_t SparseLifeGrid::ChunkKeyHash::operator()(const ChunkKey& key) const {
+  uint64_t hash = static_cast<uint64_t>(key.x) * 0x9E3779B97F4A7C15ull ^
+    static_cast<uint64_t>(key.y) * 0xC2B2AE3D27D4EB4Full;
+  return static_cast<size_t>(hash ^ (hash >> 29));
+}
+
+SparseLifeGrid::SparseLifeGrid(const GameOfLifeGrid& grid, int64_t x,
+  int64_t y) {
+  for (uint32_t i = 0; i < grid.GetHeight(); ++i)
+    for (uint32_t j = 0; j < grid.GetWight(); ++j)
+      if (ISALIVE(grid.GetCell(j, i)))
+        SetCell(x + j, y + i, aliveCell);
+}
+
+bool SparseLifeGrid::operator==(const SparseLifeGrid& grid) const {
+  if (chunks.size() != grid.chunks.size())
+    return false;
+  for (ChunkMap::const_iterator it = chunks.begin(); it != chunks.end();
+       ++it) {
+    const Chunk* other = grid.Find(it->first.x, it->first.y);
+    if (other == nullptr)
+      return false;
+    for (int64_t r = 0; r < kChunk; ++r)
+      if (it->second.rows[r] != other->rows[r])
+        return false;
+  }
+  return true;
+}
+
+bool SparseLifeGrid::operator!=(const SparseLifeGrid& grid) const {
+  return !(*this == grid);
+}
+
+const SparseLifeGrid::Chunk* SparseLifeGrid::Find(int64_t x,
+  int64_t y) const {
+  ChunkKey key = { x, y };
+  ChunkMap::const_iterator it = chunks.find(key);
+  return it == chunks.end() ? nullptr : &it->second;
+}
+
+void SparseLifeGrid::SetCell(int64_t x, int64_t y, uchar cell) {
+  ChunkKey key = { ChunkOf(x), ChunkOf(y) };
+  uint64_t bit = uint64_t(1) << OffsetOf(x);
+  ChunkMap::iterator it = chunks.find(key);
+  if (!ISALIVE(cell)) {
+    if (it == chunks.end())
+      return;
+    Chunk& chunk = it->second;
+    chunk.rows[OffsetOf(y)] &= ~bit;
+    for (int64_t r = 0; r < kChunk; ++r)
+      if (chunk.rows[r] != 0)
+        return;
+    chunks.erase(it);
+    return;
+  }
+  if (it == chunks.end()) {
+    Chunk empty = {};
+    it = chunks.insert(std::make_pair(key, empty)).first;
+  }
+  it->second.rows[OffsetOf(y)] |= bit;
+}
+
+uchar SparseLifeGrid::GetCell(int64_t x, int64_t y) const {
+  const Chunk* chunk = Find(ChunkOf(x), ChunkOf(y));
+  if (chunk == nullptr)
+    return deadCell;
+  return (chunk->rows[OffsetOf(y)] >> OffsetOf(x)) & 1 ? aliveCell :
+    deadCell;
+}
+
+GameOfLifeGrid SparseLifeGrid::Export(int64_t x, int64_t y, uint32_t wight,
+  uint32_t height) const {
+  GameOfLifeGrid grid(wight, height);
+  for (ChunkMap::const_iterator it = chunks.begin(); it != chunks.end();
+       ++it) {
+    int64_t left = it->first.x * kChunk;
+    int64_t top = it->first.y * kChunk;
+    if (left >= x + wight || left + kChunk <= x ||
+        top >= y + height || top + kChunk <= y)
+      continue;
+    for (int64_t r = 0; r < kChunk; ++r) {
+      uint64_t row = it->second.rows[r];
+      for (int64_t c = 0; row != 0; ++c, row >>= 1)
+        if ((row & 1) && left + c >= x && left + c < x + wight &&
+            top + r >= y && top + r < y + height)
+          grid.SetCell(static_cast<uint32_t>(left + c - x),
+                       static_cast<uint32_t>(top + r - y), aliveCell);
+    }
+  }
+  return grid;
+}
+
+uint64_t SparseLifeGrid::Population() const {
+  uint64_t population = 0;
+  for (ChunkMap::const_iterator it = chunks.begin(); it != chunks.end();
+       ++it)
+    for (int64_t r = 0; r < kChunk; ++r)
+      population += std::bitset<64>(it->second.rows[r]).count();
+  return population;
+}
+
+size_t SparseLifeGrid::ChunkCount() const {
+  return chunks.size();
+}
+
+bool SparseLifeGrid::StepChunk(const ChunkKey& key, Chunk* out) const {
+  static const Chunk kEmpty = {};
+  const Chunk* around[3][3];
+  for (int dy = 0; dy < 3; ++dy)
+    for (int dx = 0; dx < 3; ++dx) {
+      const Chunk* chunk = Find(key.x + dx - 1, key.y + dy - 1);
+      around[dy][dx] = chunk ? chunk : &kEmpty;
+    }
+  uint64_t any = 0;
+  for (int64_t r = 0; r < kChunk; ++r) {
+    uint64_t w[3], c[3], e[3];
+    for (int k = 0; k < 3; ++k) {
+      int64_t row = r + k - 1;
+      int dy = 1;
+      if (row < 0) {
+        row += kChunk;
+        dy = 0;
+      } else if (row >= kChunk) {
+        row -= kChunk;
+        dy = 2;
+      }
+      c[k] = around[dy][1]->rows[row];
+      w[k] = (c[k] << 1) | (around[dy][0]->rows[row] >> 63);
+      e[k] = (c[k] >> 1) | (around[dy][2]->rows[row] << 63);
+    }
+    out->rows[r] = NextLifeWord(w[0], c[0], e[0], w[1], c[1], e[1],
+                                w[2], c[2], e[2]);
+    any |= out->rows[r];
+  }
+  return any != 0;
+}
+
+SparseLifeGrid SparseLifeGrid::NextGrid() const {
+  // Every live chunk and the neighbours its border cells can reach.
+  std::unordered_set<ChunkKey, ChunkKeyHash> candidates;
+  for (ChunkMap::const_iterator it = chunks.begin(); it != chunks.end();
+       ++it) {
+    const Chunk& chunk = it->second;
+    uint64_t west = 0, east = 0;
+    for (int64_t r = 0; r < kChunk; ++r) {
+      west |= chunk.rows[r] & 1;
+      east |= chunk.rows[r] & kHighBit;
+    }
+    bool top = chunk.rows[0] != 0;
+    bool bottom = chunk.rows[kChunk - 1] != 0;
+    for (int dy = -1; dy <= 1; ++dy)
+      for (int dx = -1; dx <= 1; ++dx) {
+        if ((dx < 0 && !west) || (dx > 0 && !east) ||
+            (dy < 0 && !top) || (dy > 0 && !bottom))
+          continue;
+        if (dx != 0 && dy != 0) {
+          uint64_t row = chunk.rows[dy < 0 ? 0 : kChunk - 1];
+          if (!(row & (dx < 0 ? 1 : kHighBit)))
+            continue;
+        }
+        ChunkKey key = { it->first.x + dx, it->first.y + dy };
+        candidates.insert(key);
+      }
+  }
+  SparseLifeGrid res;
+  res.chunks.reserve(candidates.size());
+  Chunk next;
+  for (std::unordered_set<ChunkKey, ChunkKeyHash>::const_iterator it =
+       candidates.begin(); it != candidates.end(); ++it)
+    if (StepChunk(*it, &next))
+      res.chunks.insert(std::make_pair(*it, next));
+  return res;
+}
+
+void SparseLifeGrid::Step(uint32_t generations) {
+  for (uint32_t g = 0; g < generations; ++g) {
+    SparseLifeGrid next = NextGrid();
+    chunks.swap(next.chunks);
+  }
+}
@@ -0,0 +1,139 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "include/game-of-life-kernel.h"
+#include "include/game-of-life-tiled.h"
+
+TiledLifeGrid::TiledLifeGrid(uint32_t wight_, uint32_t height_,
+  uint32_t tile_) :GameOfLifeGrid(wight_, height_), tile(tile_),
+  tiles_x(0), tiles_y(0) {
+  if (tile == 0)
+    throw "tile size must be positive";
+  MarkAll();
+}
+
+TiledLifeGrid::TiledLifeGrid(const GameOfLifeGrid& grid, uint32_t tile_)
+  :GameOfLifeGrid(grid), tile(tile_), tiles_x(0), tiles_y(0) {
+  if (tile == 0)
+    throw "tile size must be positive";
+  MarkAll();
+}
+
+TiledLifeGrid& TiledLifeGrid::operator=(const TiledLifeGrid& grid) {
+  if (this == &grid)
+    return *this;
+  tile = grid.tile;
+  GameOfLifeGrid::operator=(grid);
+  return *this;
+}
+
+void TiledLifeGrid::MarkAll() {
+  tiles_x = (wight + tile - 1) / tile;
+  tiles_y = (height + tile - 1) / tile;
+  changed.assign(size_t(tiles_x) * tiles_y, 1);
+  next_changed.assign(changed.size(), 0);
+  ResetStats();
+  // The back buffer may hold anything until every tile is recomputed.
+  operator delete (back);
+  back = nullptr;
+}
+
+void TiledLifeGrid::CellsReplaced() {
+  MarkAll();
+}
+
+uint32_t TiledLifeGrid::GetTileSize() const {
+  return tile;
+}
+
+void TiledLifeGrid::SetCell(uint32_t x, uint32_t y, uchar cell) {
+  GameOfLifeGrid::SetCell(x, y, cell);
+  changed[size_t(y / tile) * tiles_x + x / tile] = 1;
+}
+
+bool TiledLifeGrid::IsTileActive(uint32_t tile_x, uint32_t tile_y) const {
+  if (tile_x >= tiles_x || tile_y >= tiles_y)
+    throw "index is out of the grid";
+  return changed[size_t(tile_y) * tiles_x + tile_x] != 0;
+}
+
+uint32_t TiledLifeGrid::ActiveTileCount() const {
+  return static_cast<uint32_t>(
+    std::count(changed.begin(), changed.end(), 1));
+}
+
+TileStats TiledLifeGrid::GetStats() const {
+  return stats;
+}
+
+void TiledLifeGrid::ResetStats() {
+  stats.tiles = changed.size();
+  stats.steps = 0;
+  stats.last_active = 0;
+  stats.total_active = 0;
+}
+
+bool TiledLifeGrid::StepTile(uint32_t tile_x, uint32_t tile_y,
+  const LifeRule& rule) {
+  const uint32_t stride = wight + 2;
+  const uint32_t first_col = tile_x * tile;
+  const uint32_t last_col = std::min(first_col + tile, wight);
+  const uint32_t first_row = tile_y * tile;
+  const uint32_t last_row = std::min(first_row + tile, height);
+  StepBlock(node, back, wight, first_row, last_row, first_col, last_col,
+    rule);
+  for (uint32_t i = first_row + 1; i <= last_row; ++i) {
+    if (memcmp(node + i * stride + first_col + 1,
+      back + i * stride + first_col + 1, last_col - first_col) != 0)
+      return true;
+  }
+  return false;
+}
+
+void TiledLifeGrid::Step(const LifeRule& rule, uint32_t generations,
+  unsigned int) {
+  if (wight == 0 || height == 0)
+    return;
+  if (back == nullptr) {
+    back = reinterpret_cast<uchar*>(operator new(sizeof(uchar) *
+      (wight + 2) * (height + 2)));
+    for (uint32_t i = 0; i < (wight + 2) * (height + 2); ++i)
+      new(back + i) uchar(deadCell);
+    std::fill(changed.begin(), changed.end(), 1);
+  }
+  // A tile that was stable under another rule may not be under this one.
+  if (rule != last_rule) {
+    last_rule = rule;
+    std::fill(changed.begin(), changed.end(), 1);
+  }
+  for (uint32_t g = 0; g < generations; ++g) {
+    uint64_t active = 0;
+    for (uint32_t ty = 0; ty < tiles_y; ++ty) {
+      uint32_t y0 = ty == 0 ? 0 : ty - 1;
+      uint32_t y1 = std::min(ty + 1, tiles_y - 1);
+      for (uint32_t tx = 0; tx < tiles_x; ++tx) {
+        uint32_t x0 = tx == 0 ? 0 : tx - 1;
+        uint32_t x1 = std::min(tx + 1, tiles_x - 1);
+        uchar dirty = 0;
+        for (uint32_t y = y0; y <= y1; ++y)
+          for (uint32_t x = x0; x <= x1; ++x)
+            dirty |= changed[size_t(y) * tiles_x + x];
+        uchar& result = next_changed[size_t(ty) * tiles_x + tx];
+        result = 0;
+        if (dirty) {
+          ++active;
+          result = StepTile(tx, ty, rule) ? 1 : 0;
+        }
+      }
+    }
+    std::swap(node, back);
+    changed.swap(next_changed);
+    ++stats.steps;
+    stats.last_active = active;
+    stats.total_active += active;
+  }
+}
@@ -1,6 +1,20 @@
 // Copyright 2020 Kriukov Dmitry
 
+#include <algorithm>
+#include <atomic>  // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
 #include "include/game-of-life.h"
+#include "include/game-of-life-kernel.h"
+#include "include/game-of-life-rule.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GAME_OF_LIFE_AVX2
+#include <immintrin.h>
+#endif
 
 #define ISDEAD(arg) (arg & 4)
 #define RESULTNORMALIZATION(arg) (arg >> 2)
@@ -8,10 +22,165 @@
 const uchar aliveCell = '*';
 const uchar deadCell = '.';
 
+namespace {
+
+// Column of three cells packed as in LifeRule: top cell in bit 2.
+inline uint32_t Column(const uchar* above, const uchar* row,
+  const uchar* below, uint32_t j) {
+  return ((~above[j] >> 2 & 1) << 2) | ((~row[j] >> 2 & 1) << 1) |
+    (~below[j] >> 2 & 1);
+}
+
+// Writes the next state of cells [first_col, last_col) of a row. The 3 x 3
+// neighbourhood index slides along the row by one column per cell, and the
+// cell is looked up in the rule table without any branches.
+inline void StepSpan(const uchar* above, const uchar* row,
+  const uchar* below, uchar* out, uint32_t first_col, uint32_t last_col,
+  const uchar* table) {
+  uint32_t index = Column(above, row, below, first_col) << 3 |
+    Column(above, row, below, first_col + 1);
+  for (uint32_t j = first_col; j < last_col; ++j) {
+    index = (index << 3 & 0x1FF) | Column(above, row, below, j + 2);
+    out[j + 1] = table[index];
+  }
+}
+
+void StepBlockScalar(const uchar* from, uchar* to, uint32_t wight,
+  uint32_t first_row, uint32_t last_row, uint32_t first_col,
+  uint32_t last_col, const LifeRule& rule) {
+  const uint32_t stride = wight + 2;
+  for (uint32_t i = first_row; i < last_row; ++i) {
+    const uchar* above = from + i * stride;
+    StepSpan(above, above + stride, above + 2 * stride,
+      to + (i + 1) * stride, first_col, last_col, rule.Table());
+  }
+}
+
+#ifdef GAME_OF_LIFE_AVX2
+bool CpuHasAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+// Same as StepBlockScalar, 32 cells at a time: the neighbours are summed
+// with byte adds of the compare masks of the eight shifted rows, and the
+// count is mapped to the next cell by a byte shuffle of the rule.
+__attribute__((target("avx2")))
+void StepBlockAvx2(const uchar* from, uchar* to, uint32_t wight,
+  uint32_t first_row, uint32_t last_row, uint32_t first_col,
+  uint32_t last_col, const LifeRule& rule) {
+  uchar born[16] = {};
+  uchar survives[16] = {};
+  for (uint32_t n = 0; n <= 8; ++n) {
+    born[n] = rule.Born(n) ? 0xFF : 0;
+    survives[n] = rule.Survives(n) ? 0xFF : 0;
+  }
+  const __m256i born_lut = _mm256_broadcastsi128_si256(
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(born)));
+  const __m256i survives_lut = _mm256_broadcastsi128_si256(
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(survives)));
+  const __m256i dead_bit = _mm256_set1_epi8(4);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i alive = _mm256_set1_epi8(static_cast<char>(aliveCell));
+  const __m256i dead = _mm256_set1_epi8(static_cast<char>(deadCell));
+  const uint32_t stride = wight + 2;
+// 0xFF for the live cells of the 32 bytes at p.
+#define ALIVE32(p) _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256( \
+    reinterpret_cast<const __m256i*>(p)), dead_bit), zero)
+  for (uint32_t i = first_row; i < last_row; ++i) {
+    const uchar* above = from + i * stride;
+    const uchar* row = above + stride;
+    const uchar* below = row + stride;
+    uchar* out = to + (i + 1) * stride;
+    uint32_t j = first_col;
+    for (; j + 32 <= last_col; j += 32) {
+      __m256i sum = _mm256_add_epi8(ALIVE32(above + j), ALIVE32(above + j + 1));
+      sum = _mm256_add_epi8(sum, ALIVE32(above + j + 2));
+      sum = _mm256_add_epi8(sum, ALIVE32(row + j));
+      sum = _mm256_add_epi8(sum, ALIVE32(row + j + 2));
+      sum = _mm256_add_epi8(sum, ALIVE32(below + j));
+      sum = _mm256_add_epi8(sum, ALIVE32(below + j + 1));
+      sum = _mm256_add_epi8(sum, ALIVE32(below + j + 2));
+      __m256i count = _mm256_sub_epi8(zero, sum);
+      __m256i next = _mm256_blendv_epi8(
+        _mm256_shuffle_epi8(born_lut, count),
+        _mm256_shuffle_epi8(survives_lut, count), ALIVE32(row + j + 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j + 1),
+        _mm256_blendv_epi8(dead, alive, next));
+    }
+    if (j < last_col)
+      StepSpan(above, row, below, out, j, last_col, rule.Table());
+  }
+#undef ALIVE32
+}
+#endif
+
+std::atomic<bool>& SimdEnabled() {
+#ifdef GAME_OF_LIFE_AVX2
+  static std::atomic<bool> enabled(CpuHasAvx2());
+#else
+  static std::atomic<bool> enabled(false);
+#endif
+  return enabled;
+}
+
+void StepRows(const uchar* from, uchar* to, uint32_t wight,
+  uint32_t first_row, uint32_t last_row, const LifeRule& rule) {
+  StepBlock(from, to, wight, first_row, last_row, 0, wight, rule);
+}
+
+// Blocks the threads of a band split until all of them have arrived.
+class Barrier {
+ public:
+  explicit Barrier(unsigned int count_) :count(count_), waiting(0),
+    generation(0) {}
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    unsigned int arrived = generation;
+    if (++waiting == count) {
+      waiting = 0;
+      ++generation;
+      condition.notify_all();
+    } else {
+      condition.wait(lock, [this, arrived] {
+        return generation != arrived;
+      });
+    }
+  }
+
+ private:
+  std::mutex mutex;
+  std::condition_variable condition;
+  unsigned int count;
+  unsigned int waiting;
+  unsigned int generation;
+};
+
+}  // namespace
+
+void StepBlock(const uchar* from, uchar* to, uint32_t wight,
+  uint32_t first_row, uint32_t last_row, uint32_t first_col,
+  uint32_t last_col, const LifeRule& rule) {
+#ifdef GAME_OF_LIFE_AVX2
+  if (SimdEnabled()) {
+    StepBlockAvx2(from, to, wight, first_row, last_row, first_col, last_col,
+      rule);
+    return;
+  }
+#endif
+  StepBlockScalar(from, to, wight, first_row, last_row, first_col, last_col,
+    rule);
+}
+
+const LifeRule& ConwayRule() {
+  static const LifeRule rule;
+  return rule;
+}
+
 GameOfLifeGrid::GameOfLifeGrid(uint32_t wight_, uint32_t height_)
                                 :wight(wight_), height(height_),
 node(reinterpret_cast<uchar*>(operator new(sizeof(uchar) *
-  (wight + 2)* (height + 2)))) {
+  (wight + 2)* (height + 2)))), back(nullptr) {
   for (uint32_t i = 0; i < (wight + 2) * (height + 2); ++i) {
     new(node + i) uchar(deadCell);
   }
@@ -20,7 +189,7 @@ node(reinterpret_cast<uchar*>(operator new(sizeof(uchar) *
 GameOfLifeGrid::GameOfLifeGrid(uint32_t wight_, uint32_t height_,
   uchar* input) :wight(wight_), height(height_),
   node(reinterpret_cast<uchar*>(operator new(sizeof(uchar) *
-  (wight + 2)* (height + 2)))) {
+  (wight + 2)* (height + 2)))), back(nullptr) {
   for (uint32_t i = 0; i < wight + 2; ++i)
     new(node + i) uchar(deadCell);
   for (uint32_t i = 1; i < height + 1; ++i) {
@@ -37,16 +206,16 @@ GameOfLifeGrid::GameOfLifeGrid(uint32_t wight_, uint32_t height_,
 GameOfLifeGrid::GameOfLifeGrid(const GameOfLifeGrid& grid):
   wight(grid.wight), height(grid.height),
   node(reinterpret_cast<uchar*>(operator new(sizeof(uchar)*
-  (wight + 2)* (height + 2)))) {
+  (wight + 2)* (height + 2)))), back(nullptr) {
   for (uint32_t i = 0; i < (wight + 2) * (height + 2); ++i)
     new(node + i) uchar(grid.node[i]);
 }
 
-uint32_t GameOfLifeGrid::GetWight() {
+uint32_t GameOfLifeGrid::GetWight() const {
   return wight;
 }
 
-uint32_t GameOfLifeGrid::GetHeight() {
+uint32_t GameOfLifeGrid::GetHeight() const {
   return height;
 }
 
@@ -66,27 +235,35 @@ bool GameOfLifeGrid::operator!=(const GameOfLifeGrid& grid) {
 }
 
 GameOfLifeGrid& GameOfLifeGrid::operator=(const GameOfLifeGrid& grid) {
+  if (this == &grid)
+    return *this;
   uint32_t size = grid.wight * grid.height;
   if (size == 0) {
     operator delete (node);
+    operator delete (back);
     node = nullptr;
+    back = nullptr;
     wight = grid.wight;
     height = grid.height;
+    CellsReplaced();
     return *this;
-  } else if (size != height * wight) {
+  } else if (grid.wight != wight || grid.height != height) {
     operator delete (node);
+    operator delete (back);
     node = reinterpret_cast<uchar*>(operator new(sizeof(uchar) *
       (grid.wight + 2) * (grid.height + 2)));
+    back = nullptr;
     wight = grid.wight;
     height = grid.height;
   }
   for (uint32_t i = 0; i < (wight + 2) * (height + 2); ++i) {
     node[i] = grid.node[i];
   }
+  CellsReplaced();
   return *this;
 }
 
-uchar GameOfLifeGrid::NeighborCount(uint32_t x, uint32_t y) {
+uchar GameOfLifeGrid::NeighborCount(uint32_t x, uint32_t y) const {
   const uchar cAllNeighborCellCount = 8;
   uchar res = 0;
   res += ISDEAD(node[y * (wight + 2) + x]);
@@ -101,27 +278,83 @@ uchar GameOfLifeGrid::NeighborCount(uint32_t x, uint32_t y) {
 }
 
 void GameOfLifeGrid::SetCell(uint32_t x, uint32_t y, uchar cell) {
-  if ((x < 0) || (x > wight) || (y < 0) || (y > height))
+  if ((x >= wight) || (y >= height))
     throw "index is out of the grid";
   node[(x + 1) + (y + 1) * (wight + 2)] = cell;
 }
 
-uchar GameOfLifeGrid::GetCell(uint32_t x, uint32_t y) {
-  if ((x < 0) || (x > wight) || (y < 0) || (y > height))
+uchar GameOfLifeGrid::GetCell(uint32_t x, uint32_t y) const {
+  if ((x >= wight) || (y >= height))
     throw "index is out of the grid";
   return node[(x + 1) + (y + 1) * (wight + 2)];
 }
 
-GameOfLifeGrid GameOfLifeGrid::NextGrid() {
+GameOfLifeGrid GameOfLifeGrid::NextGrid() const {
+  return NextGrid(ConwayRule());
+}
+
+GameOfLifeGrid GameOfLifeGrid::NextGrid(const LifeRule& rule) const {
   GameOfLifeGrid res(wight, height);
-  for (uint32_t i = 0; i < height; ++i) {
-    for (uint32_t j = 0; j < wight; ++j)
-      res.node[(i + 1) * (wight + 2) + (j + 1)] = NextCondition(j, i);
-  }
+  StepRows(node, res.node, wight, 0, height, rule);
   return res;
 }
 
-uchar GameOfLifeGrid::NextCondition(uint32_t x, uint32_t y) {
+void GameOfLifeGrid::Step(uint32_t generations, unsigned int threads_count) {
+  Step(ConwayRule(), generations, threads_count);
+}
+
+void GameOfLifeGrid::Step(const LifeRule& rule, uint32_t generations,
+  unsigned int threads_count) {
+  if (wight == 0 || height == 0 || generations == 0)
+    return;
+  if (back == nullptr) {
+    back = reinterpret_cast<uchar*>(operator new(sizeof(uchar) *
+      (wight + 2) * (height + 2)));
+    for (uint32_t i = 0; i < (wight + 2) * (height + 2); ++i)
+      new(back + i) uchar(deadCell);
+  }
+  if (threads_count == 0)
+    threads_count = std::thread::hardware_concurrency();
+  threads_count = std::max(1u, std::min(threads_count, height));
+
+  Barrier barrier(threads_count);
+  uchar* const buffers[2] = { node, back };
+  const uint32_t w = wight;
+  const uint32_t h = height;
+  auto band = [&barrier, &buffers, &rule, w, h, generations, threads_count](
+    unsigned int t) {
+    uint32_t first = static_cast<uint32_t>(uint64_t(h) * t / threads_count);
+    uint32_t last =
+      static_cast<uint32_t>(uint64_t(h) * (t + 1) / threads_count);
+    for (uint32_t g = 0; g < generations; ++g) {
+      StepRows(buffers[g % 2], buffers[(g + 1) % 2], w, first, last,
+        rule);
+      barrier.Wait();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned int t = 1; t < threads_count; ++t)
+    threads.push_back(std::thread(band, t));
+  band(0);
+  for (size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  if (generations % 2 != 0)
+    std::swap(node, back);
+}
+
+bool GameOfLifeGrid::SimdSupported() {
+#ifdef GAME_OF_LIFE_AVX2
+  return CpuHasAvx2();
+#else
+  return false;
+#endif
+}
+
+void GameOfLifeGrid::EnableSimd(bool enable) {
+  SimdEnabled() = enable && SimdSupported();
+}
+
+uchar GameOfLifeGrid::NextCondition(uint32_t x, uint32_t y) const {
   const uchar willLiveAnyway = 3;
   const uchar willLiveOnlyAlive = 2;
   uchar ncount = NeighborCount(x, y);
@@ -136,4 +369,5 @@ uchar GameOfLifeGrid::NextCondition(uint32_t x, uint32_t y) {
 
 GameOfLifeGrid::~GameOfLifeGrid() {
   operator delete (node);
+  operator delete (back);
 }
@@ -0,0 +1,24 @@
+// Copyright 2020 Kriukov Dmitry
+
+#ifndef MODULES_GAME_OF_LIFE_TEST_GAME_OF_LIFE_TEST_UTIL_H_
+#define MODULES_GAME_OF_LIFE_TEST_GAME_OF_LIFE_TEST_UTIL_H_
+
+#include <stdint.h>
+
+#include <random>
+#include <vector>
+
+#include "include/game-of-life.h"
+
+// Random soup of the given size: every cell is alive with probability
+// 1 / one_in, the same cells for the same seed.
+inline GameOfLifeGrid RandomGrid(uint32_t w, uint32_t h, unsigned seed,
+                                 unsigned one_in = 3) {
+  std::mt19937 gen(seed);
+  std::vector<uchar> input(w * h);
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = gen() % one_in == 0 ? aliveCell : deadCell;
+  return GameOfLifeGrid(w, h, input.data());
+}
+
+#endif  // MODULES_GAME_OF_LIFE_TEST_GAME_OF_LIFE_TEST_UTIL_H_
@@ -0,0 +1,177 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "include/game-of-life.h"
+#include "include/game-of-life-hashlife.h"
+#include "include/game-of-life-packed.h"
+#include "test/game-of-life-test-util.h"
+
+namespace {
+
+void AddRPentomino(HashLifeUniverse* universe, int64_t x, int64_t y) {
+  universe->SetCell(x + 1, y, aliveCell);
+  universe->SetCell(x + 2, y, aliveCell);
+  universe->SetCell(x, y + 1, aliveCell);
+  universe->SetCell(x + 1, y + 1, aliveCell);
+  universe->SetCell(x + 1, y + 2, aliveCell);
+}
+
+void AddGlider(HashLifeUniverse* universe, int64_t x, int64_t y) {
+  universe->SetCell(x + 1, y, aliveCell);
+  universe->SetCell(x + 2, y + 1, aliveCell);
+  universe->SetCell(x, y + 2, aliveCell);
+  universe->SetCell(x + 1, y + 2, aliveCell);
+  universe->SetCell(x + 2, y + 2, aliveCell);
+}
+
+}  // namespace
+
+TEST(HashLifeTest, Can_Set_And_Get_Cells_Far_Away) {
+  // Arrange
+  HashLifeUniverse universe;
+
+  // Act
+  universe.SetCell(-1000000000000, 5, aliveCell);
+  universe.SetCell(7, 3000000000000, aliveCell);
+  universe.SetCell(7, 3000000000000, deadCell);
+
+  // Assert
+  EXPECT_EQ(aliveCell, universe.GetCell(-1000000000000, 5));
+  EXPECT_EQ(deadCell, universe.GetCell(7, 3000000000000));
+  EXPECT_EQ(deadCell, universe.GetCell(0, 0));
+  EXPECT_EQ(1u, universe.Population());
+}
+
+TEST(HashLifeTest, Import_And_Export_Keep_The_Grid) {
+  // Arrange
+  GameOfLifeGrid expect = RandomGrid(37, 23, 11, 2);
+  HashLifeUniverse universe;
+
+  // Act
+  universe.Import(expect, -10, 4);
+
+  // Assert
+  EXPECT_EQ(expect, universe.Export(-10, 4, 37, 23));
+}
+
+TEST(HashLifeTest, Single_Steps_Match_Byte_Grid) {
+  // Arrange
+  std::mt19937 gen(5);
+  GameOfLifeGrid grid(64, 64);
+  for (uint32_t y = 24; y < 40; ++y)
+    for (uint32_t x = 24; x < 40; ++x)
+      grid.SetCell(x, y, gen() % 2 ? aliveCell : deadCell);
+  HashLifeUniverse universe;
+  universe.Import(grid);
+
+  // Act & Assert
+  for (int i = 0; i < 20; ++i) {
+    grid = grid.NextGrid();
+    universe.Step();
+    ASSERT_EQ(grid, universe.Export(0, 0, 64, 64)) << "generation " << i;
+  }
+  EXPECT_EQ(20u, universe.Generation());
+}
+
+TEST(HashLifeTest, Power_Of_Two_Steps_Match_Packed_Grid) {
+  // Arrange
+  PackedLifeGrid grid(512, 512);
+  grid.SetCell(257, 256, aliveCell);
+  grid.SetCell(258, 256, aliveCell);
+  grid.SetCell(256, 257, aliveCell);
+  grid.SetCell(257, 257, aliveCell);
+  grid.SetCell(257, 258, aliveCell);
+  HashLifeUniverse universe;
+  AddRPentomino(&universe, 1, 0);
+
+  // Act
+  grid.Step(192);
+  universe.SetStep(6);
+  for (int i = 0; i < 3; ++i)
+    universe.Step();
+
+  // Assert
+  EXPECT_EQ(192u, universe.Generation());
+  EXPECT_EQ(grid.ToGrid(), universe.Export(-255, -256, 512, 512));
+}
+
+TEST(HashLifeTest, R_Pentomino_Stabilizes_With_116_Cells) {
+  // Arrange
+  HashLifeUniverse universe;
+  AddRPentomino(&universe, 0, 0);
+
+  // Act
+  universe.Run(1103);
+
+  // Assert
+  EXPECT_EQ(1103u, universe.Generation());
+  EXPECT_EQ(116u, universe.Population());
+}
+
+TEST(HashLifeTest, Glider_Flies_2_To_40_Generations) {
+  // Arrange
+  HashLifeUniverse universe;
+  AddGlider(&universe, 0, 0);
+  const int64_t shift = int64_t(1) << 38;
+
+  // Act
+  universe.Run(uint64_t(1) << 40);
+
+  // Assert
+  HashLifeUniverse expect;
+  AddGlider(&expect, shift, shift);
+  EXPECT_EQ(5u, universe.Population());
+  EXPECT_EQ(expect.Export(shift - 2, shift - 2, 8, 8),
+            universe.Export(shift - 2, shift - 2, 8, 8));
+}
+
+TEST(HashLifeTest, Garbage_Collection_Keeps_The_Pattern) {
+  // Arrange
+  HashLifeUniverse limited(2000);
+  HashLifeUniverse unlimited;
+  AddRPentomino(&limited, 0, 0);
+  AddRPentomino(&unlimited, 0, 0);
+
+  // Act
+  for (int i = 0; i < 300; ++i)
+    limited.Step();
+  unlimited.Run(300);
+  limited.CollectGarbage();
+
+  // Assert
+  EXPECT_EQ(unlimited.Population(), limited.Population());
+  EXPECT_EQ(unlimited.Export(-100, -100, 200, 200),
+            limited.Export(-100, -100, 200, 200));
+  EXPECT_LT(limited.NodeCount(), 2000u);
+}
+
+TEST(HashLifeTest, Cannot_Set_Too_Large_Step) {
+  // Arrange
+  HashLifeUniverse universe;
+
+  // Act & Assert
+  EXPECT_ANY_THROW(universe.SetStep(63));
+}
+
+TEST(HashLifeTest, Long_Run_Stays_Within_Node_Limit) {
+  // Arrange
+  HashLifeUniverse limited(4096);
+  HashLifeUniverse unlimited;
+  AddRPentomino(&limited, 0, 0);
+  AddRPentomino(&unlimited, 0, 0);
+  limited.SetStep(10);
+
+  // Act
+  limited.Step();
+  unlimited.Run(1024);
+
+  // Assert
+  EXPECT_EQ(unlimited.Population(), limited.Population());
+  EXPECT_EQ(unlimited.Export(-200, -200, 400, 400),
+            limited.Export(-200, -200, 400, 400));
+  EXPECT_LT(limited.NodeCount(), 2u * 4096u);
+  EXPECT_GT(unlimited.NodeCount(), 2u * 4096u);
+}
@@ -0,0 +1,165 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "include/game-of-life.h"
+#include "include/game-of-life-io.h"
+#include "include/game-of-life-packed.h"
+#include "include/game-of-life-sparse.h"
+#include "test/game-of-life-test-util.h"
+
+namespace {
+
+const char kGliderRle[] =
+  "#N Glider\n"
+  "#C A comment\n"
+  "x = 3, y = 3, rule = B3/S23\n"
+  "bob$2bo$3o!\n";
+
+GameOfLifeGrid Glider() {
+  GameOfLifeGrid grid(3, 3);
+  grid.SetCell(1, 0, aliveCell);
+  grid.SetCell(2, 1, aliveCell);
+  grid.SetCell(0, 2, aliveCell);
+  grid.SetCell(1, 2, aliveCell);
+  grid.SetCell(2, 2, aliveCell);
+  return grid;
+}
+
+void WriteFile(const std::string& path, const std::string& text) {
+  std::ofstream out(path.c_str(), std::ios::binary);
+  out << text;
+}
+
+}  // namespace
+
+TEST(PatternIoTest, Can_Read_Rle_Into_Dense_Grid) {
+  // Arrange
+  GameOfLifeGrid grid(3, 3);
+  GridSink<GameOfLifeGrid> sink(&grid);
+
+  // Act
+  PatternInfo info = ReadRle(kGliderRle, sizeof(kGliderRle) - 1, &sink);
+
+  // Assert
+  EXPECT_EQ(Glider(), grid);
+  EXPECT_EQ(3, info.wight);
+  EXPECT_EQ(3, info.height);
+  EXPECT_EQ(5u, info.population);
+  EXPECT_EQ("B3/S23", info.rule);
+}
+
+TEST(PatternIoTest, Can_Read_Rle_Into_Sparse_Grid_With_Offset) {
+  // Arrange
+  SparseLifeGrid grid;
+  GridSink<SparseLifeGrid> sink(&grid, -1000, 5);
+
+  // Act
+  ReadRle(kGliderRle, sizeof(kGliderRle) - 1, &sink);
+
+  // Assert
+  EXPECT_EQ(Glider(), grid.Export(-1000, 5, 3, 3));
+}
+
+TEST(PatternIoTest, Test_Throw_Bad_Rle) {
+  // Arrange
+  const char text[] = "x = 3, y = 3\n2o?o!";
+  GameOfLifeGrid grid(3, 3);
+  GridSink<GameOfLifeGrid> sink(&grid);
+
+  // Act & Assert
+  EXPECT_ANY_THROW(ReadRle(text, sizeof(text) - 1, &sink));
+}
+
+TEST(PatternIoTest, Rle_Writer_Skips_Trailing_Dead_Cells) {
+  // Arrange
+  GameOfLifeGrid grid(5, 4);
+  grid.SetCell(0, 0, aliveCell);
+  grid.SetCell(1, 0, aliveCell);
+  grid.SetCell(4, 3, aliveCell);
+  std::ostringstream out;
+
+  // Act
+  WriteRle(&out, grid);
+
+  // Assert
+  EXPECT_EQ("x = 5, y = 4, rule = B3/S23\n2o3$4bo!\n", out.str());
+}
+
+TEST(PatternIoTest, Rle_Round_Trip_Of_Packed_Grid) {
+  // Arrange
+  PackedLifeGrid expect(RandomGrid(200, 90, 7, 5));
+  std::ostringstream out;
+  WriteRle(&out, expect, 0, 0, 200, 90);
+  std::string text = out.str();
+  PackedLifeGrid grid(200, 90);
+  GridSink<PackedLifeGrid> sink(&grid);
+
+  // Act
+  ReadPattern(text.data(), text.size(), &sink);
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+  std::istringstream lines(text);
+  for (std::string line; std::getline(lines, line);)
+    EXPECT_LE(line.size(), 70u);
+}
+
+TEST(PatternIoTest, Life106_Round_Trip_With_Negative_Cells) {
+  // Arrange
+  SparseLifeGrid expect;
+  expect.SetCell(-3, -7, aliveCell);
+  expect.SetCell(10, 2, aliveCell);
+  std::ostringstream out;
+  WriteLife106(&out, expect, -5, -10, 20, 20);
+  std::string text = out.str();
+  SparseLifeGrid grid;
+  GridSink<SparseLifeGrid> sink(&grid, -5, -10);
+
+  // Act
+  PatternInfo info = ReadPattern(text.data(), text.size(), &sink);
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+  EXPECT_EQ(2u, info.population);
+  EXPECT_EQ(14, info.wight);
+  EXPECT_EQ(10, info.height);
+}
+
+TEST(PatternIoTest, Can_Load_Grid_From_Files) {
+  // Arrange
+  WriteFile("glider.rle", kGliderRle);
+  WriteFile("glider.lif", "#Life 1.06\n0 -1\n1 0\n-1 1\n0 1\n1 1\n");
+
+  // Act
+  GameOfLifeGrid rle = LoadGrid("glider.rle");
+  GameOfLifeGrid life = LoadGrid("glider.lif");
+
+  // Assert
+  EXPECT_EQ(Glider(), rle);
+  EXPECT_EQ(Glider(), life);
+  std::remove("glider.rle");
+  std::remove("glider.lif");
+}
+
+TEST(PatternIoTest, Test_Throw_Missing_File) {
+  // Arrange & Act & Assert
+  EXPECT_ANY_THROW(LoadGrid("no-such-pattern.rle"));
+}
+
+TEST(PatternIoTest, Test_Throw_Grid_Over_Index_Range) {
+  // Arrange
+  WriteFile("huge.rle", "x = 70000, y = 70000\no!\n");
+  WriteFile("huge.lif", "#Life 1.06\n0 0\n69999 69999\n");
+
+  // Act & Assert
+  EXPECT_ANY_THROW(LoadGrid("huge.rle"));
+  EXPECT_ANY_THROW(LoadGrid("huge.lif"));
+  std::remove("huge.rle");
+  std::remove("huge.lif");
+}
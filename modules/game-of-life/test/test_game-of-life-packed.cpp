@@ -0,0 +1,132 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <gtest/gtest.h>
+
+#include "include/game-of-life.h"
+#include "include/game-of-life-packed.h"
+#include "test/game-of-life-test-util.h"
+
+TEST(PackedLifeGridTest, Can_Create_With_Parameters) {
+  // Arrange & Act
+  PackedLifeGrid grid(70, 3);
+
+  // Assert
+  EXPECT_EQ(70u, grid.GetWight());
+  EXPECT_EQ(3u, grid.GetHeight());
+  EXPECT_EQ(0u, grid.Population());
+}
+
+TEST(PackedLifeGridTest, Can_Step_Empty_Grids) {
+  // Arrange
+  PackedLifeGrid no_columns(0, 4);
+  PackedLifeGrid no_rows(70, 0);
+
+  // Act
+  PackedLifeGrid next_no_columns = no_columns.NextGrid();
+  PackedLifeGrid next_no_rows = no_rows.NextGrid();
+  no_columns.Step(2);
+  no_rows.Step(2);
+
+  // Assert
+  EXPECT_EQ(0u, next_no_columns.GetWight());
+  EXPECT_EQ(4u, next_no_columns.GetHeight());
+  EXPECT_EQ(0u, next_no_rows.Population());
+  EXPECT_EQ(0u, no_columns.Population());
+  EXPECT_EQ(0u, no_rows.Population());
+}
+
+TEST(PackedLifeGridTest, Converts_To_And_From_Byte_Grid) {
+  // Arrange
+  GameOfLifeGrid expect = RandomGrid(130, 7, 1);
+
+  // Act
+  PackedLifeGrid packed(expect);
+
+  // Assert
+  EXPECT_EQ(expect, packed.ToGrid());
+}
+
+TEST(PackedLifeGridTest, Test_Set_And_Get_Cell) {
+  // Arrange
+  PackedLifeGrid grid(100, 2);
+
+  // Act
+  grid.SetCell(64, 1, aliveCell);
+  grid.SetCell(63, 1, aliveCell);
+  grid.SetCell(63, 1, deadCell);
+
+  // Assert
+  EXPECT_EQ(aliveCell, grid.GetCell(64, 1));
+  EXPECT_EQ(deadCell, grid.GetCell(63, 1));
+  EXPECT_EQ(1u, grid.Population());
+}
+
+TEST(PackedLifeGridTest, Test_Throw_Index_Out_Of_Grid) {
+  // Arrange
+  PackedLifeGrid grid(3, 3);
+
+  // Act & Assert
+  EXPECT_ANY_THROW(grid.SetCell(3, 0, aliveCell));
+  EXPECT_ANY_THROW(grid.GetCell(0, 3));
+}
+
+TEST(PackedLifeGridTest, Next_Grid_Matches_Byte_Grid) {
+  // Arrange
+  GameOfLifeGrid grid = RandomGrid(200, 50, 2);
+  PackedLifeGrid packed(grid);
+
+  // Act & Assert
+  for (int i = 0; i < 20; ++i) {
+    grid = grid.NextGrid();
+    packed = packed.NextGrid();
+    ASSERT_EQ(grid, packed.ToGrid()) << "generation " << i + 1;
+  }
+}
+
+TEST(PackedLifeGridTest, Step_Matches_Next_Grid) {
+  // Arrange
+  GameOfLifeGrid grid = RandomGrid(64, 64, 3);
+  PackedLifeGrid packed(grid);
+  for (int i = 0; i < 30; ++i)
+    grid = grid.NextGrid();
+
+  // Act
+  packed.Step(30);
+
+  // Assert
+  EXPECT_EQ(grid, packed.ToGrid());
+}
+
+TEST(PackedLifeGridTest, Glider_Crosses_Word_Border) {
+  // Arrange
+  PackedLifeGrid grid(128, 10);
+  PackedLifeGrid expect(128, 10);
+  const uint32_t glider[5][2] = { {62, 0}, {63, 1}, {61, 2}, {62, 2},
+    {63, 2} };
+  for (int i = 0; i < 5; ++i) {
+    grid.SetCell(glider[i][0], glider[i][1], aliveCell);
+    expect.SetCell(glider[i][0] + 2, glider[i][1] + 2, aliveCell);
+  }
+
+  // Act
+  grid.Step(8);
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
+
+TEST(PackedLifeGridTest, Cells_Outside_The_Grid_Are_Dead) {
+  // Arrange
+  PackedLifeGrid grid(65, 3);
+  grid.SetCell(64, 0, aliveCell);
+  grid.SetCell(64, 1, aliveCell);
+  grid.SetCell(64, 2, aliveCell);
+
+  // Act
+  grid.Step();
+
+  // Assert
+  EXPECT_EQ(2u, grid.Population());
+  EXPECT_EQ(aliveCell, grid.GetCell(63, 1));
+  EXPECT_EQ(aliveCell, grid.GetCell(64, 1));
+}
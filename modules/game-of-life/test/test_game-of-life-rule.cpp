@@ -0,0 +1,122 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <gtest/gtest.h>
+
+#include "include/game-of-life.h"
+#include "include/game-of-life-rule.h"
+#include "test/game-of-life-test-util.h"
+
+namespace {
+
+// Next generation by the rule, cell by cell through NeighborCount.
+GameOfLifeGrid SlowNextGrid(const GameOfLifeGrid& grid,
+                            const LifeRule& rule) {
+  GameOfLifeGrid res(grid.GetWight(), grid.GetHeight());
+  for (uint32_t y = 0; y < grid.GetHeight(); ++y)
+    for (uint32_t x = 0; x < grid.GetWight(); ++x) {
+      uint32_t n = grid.NeighborCount(x, y);
+      bool alive = grid.GetCell(x, y) == aliveCell ? rule.Survives(n) :
+        rule.Born(n);
+      res.SetCell(x, y, alive ? aliveCell : deadCell);
+    }
+  return res;
+}
+
+}  // namespace
+
+TEST(LifeRuleTest, Default_Rule_Is_Conway) {
+  // Arrange & Act
+  LifeRule rule;
+
+  // Assert
+  EXPECT_EQ("B3/S23", rule.ToString());
+  EXPECT_TRUE(rule.Born(3));
+  EXPECT_FALSE(rule.Born(2));
+  EXPECT_TRUE(rule.Survives(2));
+  EXPECT_FALSE(rule.Survives(4));
+}
+
+TEST(LifeRuleTest, Can_Parse_Rule_Forms) {
+  // Arrange & Act
+  LifeRule high("B36/S23");
+  LifeRule reversed("s23/b63");
+  LifeRule legacy("23/36");
+
+  // Assert
+  EXPECT_EQ("B36/S23", high.ToString());
+  EXPECT_EQ(high, reversed);
+  EXPECT_EQ(high, legacy);
+  EXPECT_NE(high, LifeRule());
+}
+
+TEST(LifeRuleTest, Test_Throw_Bad_Rule) {
+  // Arrange & Act & Assert
+  EXPECT_ANY_THROW(LifeRule("B3S23"));
+  EXPECT_ANY_THROW(LifeRule("B39/S23"));
+  EXPECT_ANY_THROW(LifeRule("B3/B23"));
+  EXPECT_ANY_THROW(LifeRule("3/S23"));
+  EXPECT_ANY_THROW(LifeRule("B3/S2/3"));
+}
+
+TEST(LifeRuleTest, Table_Matches_Neighbour_Count) {
+  // Arrange
+  LifeRule rule("B2/S");
+
+  // Act
+  const uchar* table = rule.Table();
+
+  // Assert
+  EXPECT_EQ(aliveCell, table[0x101]);
+  EXPECT_EQ(deadCell, table[0x111]);
+  EXPECT_EQ(deadCell, table[0x107]);
+}
+
+TEST(LifeRuleTest, NextGrid_By_Rule_Matches_Slow_Rule) {
+  // Arrange
+  const char* rules[] = { "B3/S23", "B36/S23", "B2/S", "B1357/S1357",
+                          "B0/S8" };
+  GameOfLifeGrid grid = RandomGrid(41, 29, 11);
+
+  for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); ++i) {
+    LifeRule rule(rules[i]);
+
+    // Act
+    GameOfLifeGrid next = grid.NextGrid(rule);
+
+    // Assert
+    EXPECT_EQ(SlowNextGrid(grid, rule), next);
+  }
+}
+
+TEST(LifeRuleTest, Step_By_Rule_Matches_NextGrid_In_Threads) {
+  // Arrange
+  LifeRule rule("B36/S23");
+  GameOfLifeGrid expect = RandomGrid(60, 45, 12);
+  GameOfLifeGrid grid(expect);
+  for (int g = 0; g < 9; ++g)
+    expect = expect.NextGrid(rule);
+
+  // Act
+  grid.Step(rule, 9, 4);
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
+
+TEST(LifeRuleTest, HighLife_Replicator_Differs_From_Life) {
+  // Arrange
+  GameOfLifeGrid grid(20, 20);
+  const uint32_t cells[][2] = { {10, 8}, {11, 8}, {12, 8}, {9, 9}, {12, 9},
+                                {8, 10}, {12, 10}, {8, 11}, {11, 11},
+                                {8, 12}, {9, 12}, {10, 12} };
+  for (size_t i = 0; i < sizeof(cells) / sizeof(cells[0]); ++i)
+    grid.SetCell(cells[i][0], cells[i][1], aliveCell);
+  GameOfLifeGrid life(grid);
+
+  // Act
+  grid.Step(LifeRule("B36/S23"), 12);
+  life.Step(12);
+
+  // Assert
+  EXPECT_FALSE(life == grid);
+}
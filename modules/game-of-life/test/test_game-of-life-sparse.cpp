@@ -0,0 +1,107 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <gtest/gtest.h>
+
+#include "include/game-of-life.h"
+#include "include/game-of-life-packed.h"
+#include "include/game-of-life-sparse.h"
+#include "test/game-of-life-test-util.h"
+
+namespace {
+
+void AddGlider(SparseLifeGrid* grid, int64_t x, int64_t y) {
+  grid->SetCell(x + 1, y, aliveCell);
+  grid->SetCell(x + 2, y + 1, aliveCell);
+  grid->SetCell(x, y + 2, aliveCell);
+  grid->SetCell(x + 1, y + 2, aliveCell);
+  grid->SetCell(x + 2, y + 2, aliveCell);
+}
+
+}  // namespace
+
+TEST(SparseLifeGridTest, Empty_Grid_Has_No_Chunks) {
+  // Arrange & Act
+  SparseLifeGrid grid;
+
+  // Assert
+  EXPECT_EQ(0u, grid.ChunkCount());
+  EXPECT_EQ(0u, grid.Population());
+  EXPECT_EQ(deadCell, grid.GetCell(-5, 1000000000000));
+}
+
+TEST(SparseLifeGridTest, Test_Set_And_Get_Negative_Cells) {
+  // Arrange
+  SparseLifeGrid grid;
+
+  // Act
+  grid.SetCell(-1, -1, aliveCell);
+  grid.SetCell(-64, 63, aliveCell);
+  grid.SetCell(-65, 64, aliveCell);
+
+  // Assert
+  EXPECT_EQ(aliveCell, grid.GetCell(-1, -1));
+  EXPECT_EQ(aliveCell, grid.GetCell(-64, 63));
+  EXPECT_EQ(aliveCell, grid.GetCell(-65, 64));
+  EXPECT_EQ(deadCell, grid.GetCell(0, 0));
+  EXPECT_EQ(3u, grid.ChunkCount());
+}
+
+TEST(SparseLifeGridTest, Killing_Last_Cell_Frees_Chunk) {
+  // Arrange
+  SparseLifeGrid grid;
+  grid.SetCell(100, 100, aliveCell);
+
+  // Act
+  grid.SetCell(100, 100, deadCell);
+
+  // Assert
+  EXPECT_EQ(0u, grid.ChunkCount());
+}
+
+TEST(SparseLifeGridTest, Step_Matches_Packed_Grid) {
+  // Arrange
+  // The soup cannot reach the dead border of the packed grid in 30 steps.
+  GameOfLifeGrid start = RandomGrid(150, 130, 5);
+  for (uint32_t y = 0; y < 130; ++y)
+    for (uint32_t x = 0; x < 150; ++x)
+      if (x < 35 || x >= 115 || y < 35 || y >= 95)
+        start.SetCell(x, y, deadCell);
+  PackedLifeGrid expect(start);
+  SparseLifeGrid grid(start, -70, -40);
+
+  // Act
+  expect.Step(30);
+  grid.Step(30);
+
+  // Assert
+  EXPECT_EQ(expect.ToGrid(), grid.Export(-70, -40, 150, 130));
+}
+
+TEST(SparseLifeGridTest, Glider_Travels_Without_Border) {
+  // Arrange
+  SparseLifeGrid grid;
+  AddGlider(&grid, 0, 0);
+  SparseLifeGrid expect;
+  AddGlider(&expect, 1000, 1000);
+
+  // Act
+  grid.Step(4000);
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+  EXPECT_EQ(5u, grid.Population());
+  EXPECT_LE(grid.ChunkCount(), 4u);
+}
+
+TEST(SparseLifeGridTest, Dying_Pattern_Frees_All_Chunks) {
+  // Arrange
+  SparseLifeGrid grid;
+  grid.SetCell(63, 63, aliveCell);
+  grid.SetCell(64, 64, aliveCell);
+
+  // Act
+  grid.Step();
+
+  // Assert
+  EXPECT_EQ(0u, grid.ChunkCount());
+}
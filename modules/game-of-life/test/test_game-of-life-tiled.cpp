@@ -0,0 +1,183 @@
+// Copyright 2020 Kriukov Dmitry
+
+#include <gtest/gtest.h>
+
+#include "include/game-of-life.h"
+#include "include/game-of-life-rule.h"
+#include "include/game-of-life-tiled.h"
+#include "test/game-of-life-test-util.h"
+
+TEST(TiledLifeGridTest, Can_Create_With_Parameters) {
+  // Arrange & Act
+  TiledLifeGrid grid(100, 40, 16);
+
+  // Assert
+  EXPECT_EQ(100u, grid.GetWight());
+  EXPECT_EQ(40u, grid.GetHeight());
+  EXPECT_EQ(16u, grid.GetTileSize());
+  EXPECT_EQ(21u, grid.GetStats().tiles);
+}
+
+TEST(TiledLifeGridTest, Test_Throw_Zero_Tile_Size) {
+  // Arrange & Act & Assert
+  EXPECT_ANY_THROW(TiledLifeGrid(10, 10, 0));
+}
+
+TEST(TiledLifeGridTest, Step_Matches_NextGrid) {
+  // Arrange
+  GameOfLifeGrid expect = RandomGrid(77, 53, 3);
+  TiledLifeGrid grid(expect, 8);
+
+  // Act
+  for (int g = 0; g < 60; ++g) {
+    expect = expect.NextGrid();
+    grid.Step();
+  }
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
+
+TEST(TiledLifeGridTest, Still_Life_Becomes_Inactive) {
+  // Arrange
+  TiledLifeGrid grid(64, 64, 16);
+  grid.SetCell(20, 20, aliveCell);
+  grid.SetCell(21, 20, aliveCell);
+  grid.SetCell(20, 21, aliveCell);
+  grid.SetCell(21, 21, aliveCell);
+
+  // Act
+  grid.Step(3);
+
+  // Assert
+  EXPECT_EQ(0u, grid.ActiveTileCount());
+  EXPECT_EQ(0u, grid.GetStats().last_active);
+  EXPECT_EQ(aliveCell, grid.GetCell(21, 21));
+}
+
+TEST(TiledLifeGridTest, Only_Tiles_Near_Blinker_Are_Active) {
+  // Arrange
+  TiledLifeGrid grid(128, 128, 16);
+  grid.SetCell(40, 40, aliveCell);
+  grid.SetCell(41, 40, aliveCell);
+  grid.SetCell(42, 40, aliveCell);
+  grid.Step(2);
+  grid.ResetStats();
+
+  // Act
+  grid.Step(10);
+
+  // Assert
+  EXPECT_TRUE(grid.IsTileActive(2, 2));
+  EXPECT_FALSE(grid.IsTileActive(6, 6));
+  EXPECT_EQ(10u, grid.GetStats().steps);
+  EXPECT_EQ(9u, grid.GetStats().last_active);
+  EXPECT_EQ(aliveCell, grid.GetCell(40, 40));
+}
+
+TEST(TiledLifeGridTest, SetCell_Wakes_Up_Stable_Tile) {
+  // Arrange
+  GameOfLifeGrid expect(48, 48);
+  TiledLifeGrid grid(48, 48, 8);
+  grid.Step(2);
+
+  // Act
+  grid.SetCell(30, 30, aliveCell);
+  grid.SetCell(31, 30, aliveCell);
+  grid.SetCell(32, 30, aliveCell);
+  expect.SetCell(30, 30, aliveCell);
+  expect.SetCell(31, 30, aliveCell);
+  expect.SetCell(32, 30, aliveCell);
+  grid.Step(5);
+  for (int g = 0; g < 5; ++g)
+    expect = expect.NextGrid();
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
+
+TEST(TiledLifeGridTest, Step_Uses_Given_Rule) {
+  // Arrange
+  LifeRule highlife("B36/S23");
+  LifeRule seeds("B2/S");
+  GameOfLifeGrid expect = RandomGrid(70, 45, 4);
+  TiledLifeGrid grid(expect, 16);
+
+  // Act
+  for (int g = 0; g < 20; ++g) {
+    expect = expect.NextGrid(highlife);
+    grid.Step(highlife);
+  }
+  for (int g = 0; g < 5; ++g) {
+    expect = expect.NextGrid(seeds);
+    grid.Step(seeds);
+  }
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
+
+TEST(TiledLifeGridTest, Scalar_And_Simd_Tiles_Match) {
+  // Arrange
+  GameOfLifeGrid expect = RandomGrid(131, 67, 5);
+  TiledLifeGrid grid(expect, 40);
+
+  // Act
+  GameOfLifeGrid::EnableSimd(false);
+  for (int g = 0; g < 30; ++g)
+    expect = expect.NextGrid();
+  GameOfLifeGrid::EnableSimd(true);
+  grid.Step(30);
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
+
+TEST(TiledLifeGridTest, Works_Through_Base_Reference) {
+  // Arrange
+  GameOfLifeGrid expect(48, 48);
+  TiledLifeGrid tiled(48, 48, 8);
+  GameOfLifeGrid& grid = tiled;
+  grid.Step(2);
+
+  // Act
+  grid.SetCell(30, 30, aliveCell);
+  grid.SetCell(31, 30, aliveCell);
+  grid.SetCell(32, 30, aliveCell);
+  expect.SetCell(30, 30, aliveCell);
+  expect.SetCell(31, 30, aliveCell);
+  expect.SetCell(32, 30, aliveCell);
+  grid.Step(5, 2);
+  for (int g = 0; g < 5; ++g)
+    expect = expect.NextGrid();
+
+  // Assert
+  EXPECT_EQ(expect, grid);
+  EXPECT_GT(tiled.ActiveTileCount(), 0u);
+}
+
+TEST(TiledLifeGridTest, Assignment_Through_Base_Reference_Resets_Tiles) {
+  // Arrange
+  GameOfLifeGrid expect = RandomGrid(40, 40, 6);
+  TiledLifeGrid tiled(40, 40, 8);
+  tiled.Step(3);
+  GameOfLifeGrid& grid = tiled;
+
+  // Act
+  grid = expect;
+  tiled.Step(4);
+  for (int g = 0; g < 4; ++g)
+    expect = expect.NextGrid();
+
+  // Assert
+  EXPECT_EQ(expect, tiled);
+}
+
+TEST(TiledLifeGridTest, Can_Delete_Through_Base_Pointer) {
+  // Arrange
+  GameOfLifeGrid* grid = new TiledLifeGrid(20, 20, 4);
+  grid->Step(2);
+
+  // Act & Assert
+  EXPECT_NO_THROW(delete grid);
+}
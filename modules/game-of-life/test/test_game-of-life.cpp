@@ -2,9 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
 #include <string>
+#include <vector>
 
 #include "include/game-of-life.h"
+#include "include/game-of-life-rule.h"
+#include "test/game-of-life-test-util.h"
 
 
 TEST(GameOfLifeTest, Can_Create_Default_Grid) {
@@ -292,3 +296,107 @@ TEST(GameOfLifeTest, Test_Get_Next_Grid) {
   // Act & Assert
   EXPECT_EQ(expect, grid.NextGrid());
 }
+
+TEST(GameOfLifeTest, Test_Step_Blinker_Has_Period_Two) {
+  // Arrange
+  uint32_t w = 3;
+  uint32_t h = 3;
+  unsigned char input[] = { deadCell, aliveCell, deadCell,
+    deadCell, aliveCell, deadCell, deadCell, aliveCell, deadCell };
+  unsigned char flipped[] = { deadCell, deadCell, deadCell,
+    aliveCell, aliveCell, aliveCell, deadCell, deadCell, deadCell };
+  GameOfLifeGrid grid(w, h, input);
+  GameOfLifeGrid expect_odd(w, h, flipped);
+  GameOfLifeGrid expect_even(w, h, input);
+  // Act & Assert
+  grid.Step();
+  EXPECT_EQ(expect_odd, grid);
+  grid.Step(3);
+  EXPECT_EQ(expect_even, grid);
+}
+
+TEST(GameOfLifeTest, Test_Step_Matches_Next_Grid_In_Threads) {
+  // Arrange
+  uint32_t w = 97;
+  uint32_t h = 61;
+  const GameOfLifeGrid start = RandomGrid(w, h, 7);
+  GameOfLifeGrid expect = start;
+  for (int i = 0; i < 25; ++i)
+    expect = expect.NextGrid();
+  // Act & Assert
+  const unsigned int threads[] = { 1, 2, 4, 0 };
+  for (int i = 0; i < 4; ++i) {
+    GameOfLifeGrid grid(start);
+    grid.Step(10, threads[i]);
+    grid.Step(15, threads[i]);
+    EXPECT_EQ(expect, grid) << threads[i] << " threads";
+  }
+}
+
+TEST(GameOfLifeTest, Test_Step_More_Threads_Than_Rows) {
+  // Arrange
+  uint32_t w = 4;
+  uint32_t h = 2;
+  unsigned char input[] = { aliveCell, aliveCell, deadCell, deadCell,
+    aliveCell, aliveCell, deadCell, deadCell };
+  GameOfLifeGrid grid(w, h, input);
+  GameOfLifeGrid expect(w, h, input);
+  // Act
+  grid.Step(5, 8);
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
+
+TEST(GameOfLifeTest, Test_Step_After_Assignment_Of_Other_Size) {
+  // Arrange
+  uint32_t w = 3;
+  uint32_t h = 3;
+  unsigned char input[] = { deadCell, aliveCell, deadCell,
+    deadCell, aliveCell, deadCell, deadCell, aliveCell, deadCell };
+  GameOfLifeGrid expect(w, h, input);
+  GameOfLifeGrid grid(5, 2);
+  grid.Step();
+  // Act
+  grid = expect;
+  grid.Step(2);
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
+
+TEST(GameOfLifeTest, Test_Simd_And_Scalar_Are_Byte_Identical) {
+  // Arrange
+  const uint32_t widths[] = { 1, 31, 32, 33, 64, 95, 200 };
+  const uint32_t h = 37;
+  const LifeRule rules[] = { LifeRule(), LifeRule("B36/S23"),
+    LifeRule("B0123/S45678") };
+  std::mt19937 gen(21);
+  for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); ++w) {
+    std::vector<uchar> input(widths[w] * h);
+    for (size_t i = 0; i < input.size(); ++i)
+      input[i] = static_cast<uchar>(gen());
+    GameOfLifeGrid grid(widths[w], h, input.data());
+    for (size_t r = 0; r < sizeof(rules) / sizeof(rules[0]); ++r) {
+      // Act
+      GameOfLifeGrid::EnableSimd(false);
+      GameOfLifeGrid scalar = grid.NextGrid(rules[r]);
+      GameOfLifeGrid::EnableSimd(true);
+      GameOfLifeGrid simd = grid.NextGrid(rules[r]);
+      // Assert
+      EXPECT_EQ(scalar, simd) << "width " << widths[w] << ", rule " << r;
+    }
+  }
+}
+
+TEST(GameOfLifeTest, Test_Step_Blinker_With_Simd) {
+  // Arrange
+  GameOfLifeGrid grid(40, 3);
+  grid.SetCell(10, 1, aliveCell);
+  grid.SetCell(11, 1, aliveCell);
+  grid.SetCell(12, 1, aliveCell);
+  GameOfLifeGrid expect(grid);
+  // Act
+  GameOfLifeGrid::EnableSimd(true);
+  grid.Step(4, 2);
+  // Assert
+  EXPECT_EQ(expect, grid);
+}
@@ -0,0 +1,143 @@
+// Copyright 2020 Sokolov Andrey
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cmath>
+#include <random>
+
+#include "include/matrix_gemm.h"
+#include "include/matrix_operations.h"
+#include "include/matrix_parallel.h"
+
+namespace {
+
+const unsigned kSeed = 20200401;
+const int kMinSize = 64;
+const int kMaxSize = 8192;
+const int kMaxThreads = 1024;
+const int kStartSize = 512;
+const int kMaxNaiveSize = 512;
+const int kSamples = 64;
+const double kFlopsPerMeasurement = 4e9;
+
+Matrix randomMatrix(const int _size, std::mt19937* _gen) {
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Matrix result(_size, _size);
+    for (int idx{0}; idx < _size; ++idx) {
+        for (int jdx{0}; jdx < _size; ++jdx) {
+            result(idx, jdx) = dist(*_gen);
+        }
+    }
+    return result;
+}
+
+// The textbook i-j-k loop, for comparison.
+Matrix naiveProduct(const Matrix& _a, const Matrix& _b) {
+    const int size = _a.getRows();
+    Matrix result(size, size);
+    for (int idx{0}; idx < size; ++idx) {
+        for (int jdx{0}; jdx < size; ++jdx) {
+            double sum = 0.0;
+            for (int kdx{0}; kdx < size; ++kdx) {
+                sum += _a(idx, kdx) * _b(kdx, jdx);
+            }
+            result(idx, jdx) = sum;
+        }
+    }
+    return result;
+}
+
+// Compares random elements of the product with their dot products.
+bool checkProduct(const Matrix& _a, const Matrix& _b, const Matrix& _c,
+                  std::mt19937* _gen) {
+    const int size = _a.getRows();
+    for (int sample{0}; sample < kSamples; ++sample) {
+        int idx = static_cast<int>((*_gen)() % size);
+        int jdx = static_cast<int>((*_gen)() % size);
+        double sum = 0.0;
+        double scale = 0.0;
+        for (int kdx{0}; kdx < size; ++kdx) {
+            sum += _a(idx, kdx) * _b(kdx, jdx);
+            scale += std::fabs(_a(idx, kdx) * _b(kdx, jdx));
+        }
+        if (std::fabs(sum - _c(idx, jdx)) > 1e-12 * size * scale) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Seconds per product, the best of several runs.
+double measure(const Matrix& _a, const Matrix& _b, bool _naive,
+               Matrix* _result) {
+    const double flops = 2.0 * _a.getRows() * _a.getRows() * _a.getRows();
+    const int repeats = std::max(1, static_cast<int>(
+        kFlopsPerMeasurement / flops));
+    double best = 0.0;
+    for (int run{0}; run < repeats; ++run) {
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        *_result = _naive ? naiveProduct(_a, _b) : _a * _b;
+        double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        if (run == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+    return best;
+}
+
+bool parseInt(const char* _arg, const int _min, const int _max,
+              int* _value) {
+    char* end = nullptr;
+    long parsed = strtol(_arg, &end, 10);  // NOLINT(runtime/int)
+    if (end == _arg || *end != '\0' || parsed < _min || parsed > _max) {
+        return false;
+    }
+    *_value = static_cast<int>(parsed);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+    int maxSize = 2048;
+    int threads = 1;
+    if ((argc > 1 && !parseInt(argv[1], kMinSize, kMaxSize, &maxSize)) ||
+        (argc > 2 && !parseInt(argv[2], 0, kMaxThreads, &threads)) ||
+        argc > 3) {
+        printf("Usage: %s [max_size (%d..%d, default 2048) "
+               "[threads (0 - all cores, default 1)]]\n", argv[0],
+               kMinSize, kMaxSize);
+        return 1;
+    }
+    Matrix::setThreads(static_cast<unsigned>(threads));
+
+    printf("Matrix multiplication benchmark, seed %u, kernel %s, "
+           "%u threads\n", kSeed, gemmUsesSimd() ? "AVX2/FMA" : "portable",
+           resolveThreads(Matrix::getThreads()));
+    printf("%6s %-8s %12s %12s\n", "size", "method", "seconds", "GFLOP/s");
+
+    std::mt19937 gen(kSeed);
+    for (int size = std::min(kStartSize, maxSize); size <= maxSize;
+         size *= 2) {
+        Matrix a = randomMatrix(size, &gen);
+        Matrix b = randomMatrix(size, &gen);
+        const double flops = 2.0 * size * size * size;
+        for (int method{0}; method < 2; ++method) {
+            bool naive = method == 1;
+            if (naive && size > kMaxNaiveSize) {
+                continue;
+            }
+            Matrix c(size, size);
+            double seconds = measure(a, b, naive, &c);
+            printf("%6d %-8s %12.4f %12.2f%s\n", size,
+                   naive ? "naive" : "gemm", seconds, flops / seconds / 1e9,
+                   checkProduct(a, b, c, &gen) ? "" : "  WRONG RESULT");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,23 @@
+// Copyright 2020 Sokolov Andrey
+
+#ifndef MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_GEMM_H_
+#define MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_GEMM_H_
+
+#include "include/matrix_operations.h"
+
+// _c += _a * _b, where _a is m x k, _b is k x n and _c is m x n; any of them
+// may be a block of a larger matrix. Blocks of _a and _b are packed into
+// cache-sized panels and multiplied by a 6 x 8 register-blocked kernel,
+// which uses AVX2 and FMA when the CPU has them and plain loops otherwise.
+// With _threads > 1 (0 - all cores) _c is split into a grid of tiles computed
+// in parallel; the result is the same for any number of threads.
+void gemm(const ConstMatrixView& _a, const ConstMatrixView& _b,
+          const MatrixView& _c, const unsigned _threads = 1);
+
+// Whether gemm runs the AVX2/FMA kernel. It is chosen by the CPU features;
+// gemmEnableSimd(false) switches to the portable kernel, true switches back
+// if the CPU supports it.
+bool gemmUsesSimd();
+void gemmEnableSimd(const bool _enable);
+
+#endif  // MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_GEMM_H_
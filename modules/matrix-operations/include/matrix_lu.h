@@ -0,0 +1,52 @@
+// Copyright 2020 Sokolov Andrey
+
+#ifndef MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_LU_H_
+#define MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_LU_H_
+
+#include <vector>
+
+#include "include/matrix_operations.h"
+
+// P * A = L * U of a square matrix with partial (row) pivoting. Columns are
+// factored in panels; the trailing part of the matrix is updated with gemm,
+// so most of the O(n^3) work runs in the blocked kernel and on
+// Matrix::getThreads() threads. One decomposition serves any number of
+// solves at O(n^2) each.
+class LuDecomposition {
+ public:
+    explicit LuDecomposition(const ConstMatrixView& _matrix);
+
+    int getSize() const;
+    // L below the diagonal (its unit diagonal is not stored) and U on and
+    // above it, in one matrix.
+    const Matrix& getFactors() const;
+    // Row _idx was swapped with row getPivots()[_idx] at step _idx.
+    const std::vector<int>& getPivots() const;
+
+    // Whether a pivot is exactly zero; solves throw then.
+    bool isSingular() const;
+    double determinant() const;
+
+    // X with A * X = _b for every column of _b.
+    Matrix solve(const Matrix& _b) const;
+    std::vector<double> solve(const std::vector<double>& _b) const;
+    // x with A^T * x = _b.
+    std::vector<double> solveTransposed(const std::vector<double>& _b) const;
+
+    // A^-1 from n solves with the columns of the identity, 8/3 n^3 flops
+    // together with the factorization.
+    Matrix inverse() const;
+    // Estimate of ||A||_1 * ||A^-1||_1 by Hager's method: a few solves with
+    // A and A^T, O(n^2). It is a lower bound and is rarely off by more than
+    // a factor of 3. Infinity for a singular matrix.
+    double conditionEstimate() const;
+
+ private:
+    Matrix lu;
+    std::vector<int> pivots;
+    double norm;
+    bool oddSwaps;
+    bool singular;
+};
+
+#endif  // MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_LU_H_
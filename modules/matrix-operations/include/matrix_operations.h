@@ -1,25 +1,167 @@
 // Copyright 2020 Sokolov Andrey
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 #include <vector>
 
 #ifndef MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_OPERATIONS_H_
 #define MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_OPERATIONS_H_
 
+// Allocator of memory aligned to Alignment bytes, so that every matrix row
+// starts on a cache line.
+template <typename T, std::size_t Alignment>
+class AlignedAllocator {
+ public:
+    typedef T value_type;
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() {}
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}  // NOLINT
+
+    T* allocate(std::size_t _count) {
+#ifdef _WIN32
+        void* ptr = _aligned_malloc(_count * sizeof(T), Alignment);
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+#else
+        void* ptr = nullptr;
+        if (posix_memalign(&ptr, Alignment, _count * sizeof(T)) != 0) {
+            throw std::bad_alloc();
+        }
+#endif
+        return static_cast<T*>(ptr);
+    }
+    void deallocate(T* _ptr, std::size_t) {
+#ifdef _WIN32
+        _aligned_free(_ptr);
+#else
+        free(_ptr);
+#endif
+    }
+
+    template <typename U>
+    bool operator== (const AlignedAllocator<U, Alignment>&) const {
+        return true;
+    }
+    template <typename U>
+    bool operator!= (const AlignedAllocator<U, Alignment>&) const {
+        return false;
+    }
+};
+
+// Non-owning window into a matrix: rows x cols elements, stride elements
+// apart from one row to the next. Views of a row, a column or a block are
+// made without copying; they are valid while the matrix is not resized.
+template <typename T>
+class BasicMatrixView {
+ public:
+    BasicMatrixView(T* _ptr, const int _rows, const int _cols,
+                    const int _stride) : ptr(_ptr), rows(_rows),
+                                         cols(_cols), stride(_stride) {}
+    template <typename U>
+    BasicMatrixView(const BasicMatrixView<U>& _view)  // NOLINT
+        : ptr(_view.dataPtr()), rows(_view.getRows()),
+          cols(_view.getCols()), stride(_view.getStride()) {}
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getStride() const { return stride; }
+    T* dataPtr() const { return ptr; }
+    T* rowPtr(const int _row) const {
+        return ptr + static_cast<std::ptrdiff_t>(_row) * stride;
+    }
+    T& operator() (const int _row, const int _col) const {
+        return rowPtr(_row)[_col];
+    }
+
+    BasicMatrixView block(const int _row, const int _col,
+                          const int _rows, const int _cols) const {
+        return BasicMatrixView(rowPtr(_row) + _col, _rows, _cols, stride);
+    }
+
+ private:
+    T* ptr;
+    int rows;
+    int cols;
+    int stride;
+};
+
+typedef BasicMatrixView<double> MatrixView;
+typedef BasicMatrixView<const double> ConstMatrixView;
+
+class LuDecomposition;
+
+// Dense matrix stored in one contiguous row-major buffer. Rows are padded
+// to a multiple of kAlignment bytes, the padding is always zero.
 class Matrix {
  public:
+    static const std::size_t kAlignment = 64;
+
     Matrix(const int _rows, const int _cols);
     Matrix(const int _rows,
            const int _cols,
            std::vector<std::vector<double>> _data);
     Matrix(const Matrix& _matrix);
+    explicit Matrix(const ConstMatrixView& _view);
 
     int getRows() const;
     int getCols() const;
+    // Elements between the starts of two rows.
+    int getStride() const;
+    // Deep copy of the elements as vectors of rows.
     std::vector<std::vector<double>> getData() const;
 
     void setRows(const int _rows);
     void setCols(const int _cols);
     void setData(std::vector<std::vector<double>> _data);
 
+    // Element access. The non-const overloads may be used to write, so they
+    // drop the cached LU decomposition (see factorize()), like writable views.
+    double& operator() (const int _row, const int _col) {
+        factors.reset();
+        return data[static_cast<std::size_t>(_row) * stride + _col];
+    }
+    const double& operator() (const int _row, const int _col) const {
+        return data[static_cast<std::size_t>(_row) * stride + _col];
+    }
+    double* dataPtr() {
+        factors.reset();
+        return data.data();
+    }
+    const double* dataPtr() const { return data.data(); }
+    double* rowPtr(const int _row) {
+        factors.reset();
+        return data.data() + static_cast<std::size_t>(_row) * stride;
+    }
+    const double* rowPtr(const int _row) const {
+        return data.data() + static_cast<std::size_t>(_row) * stride;
+    }
+
+    MatrixView view();
+    ConstMatrixView view() const;
+    MatrixView row(const int _row);
+    ConstMatrixView row(const int _row) const;
+    MatrixView col(const int _col);
+    ConstMatrixView col(const int _col) const;
+    MatrixView block(const int _row, const int _col,
+                     const int _rows, const int _cols);
+    ConstMatrixView block(const int _row, const int _col,
+                          const int _rows, const int _cols) const;
+
+    // Threads used by +, -, * and the scalar product: 1 by default, 0 means
+    // all cores. Results do not depend on it.
+    static void setThreads(const unsigned _threads);
+    static unsigned getThreads();
+
     Matrix operator+ (const Matrix& _matrix) const;
     Matrix operator- (const Matrix& _matrix) const;
     Matrix operator* (const double& _scalar) const;
@@ -30,14 +172,41 @@ class Matrix {
     bool operator== (const Matrix& _matrix) const;
     bool operator!= (const Matrix& _matrix) const;
 
-    double determinant();
-    Matrix transpose();
-    Matrix takeInverseMatrix();
+    // LU decomposition of the matrix, made on the first call and kept until
+    // setData(), setRows(), setCols(), assignment or a non-const accessor or
+    // view. Writes through pointers or views taken before the call are not
+    // noticed. Copies start without it. The caller shares ownership, so the
+    // result stays valid after the matrix changes. Const members may be
+    // called from several threads at once.
+    std::shared_ptr<const LuDecomposition> factorize() const;
+    double determinant() const;
+    // X with (*this) * X = _b for every column of _b, from factorize().
+    Matrix solve(const Matrix& _b) const;
+    std::vector<double> solve(const std::vector<double>& _b) const;
+    Matrix transpose() const;
+    // Inverse from factorize(); throws for a singular matrix.
+    Matrix takeInverseMatrix() const;
+    // Estimate of the 1-norm condition number from factorize().
+    double conditionNumber() const;
+    // Newton-Schulz steps X += X * (I - A * X) starting from _inverse, until
+    // ||I - A * X||_1 <= _tolerance, it stops falling, or after _maxSteps.
+    // Each step costs two products, so it is a polish for an inverse that
+    // is already close, not a way to compute one.
+    Matrix refineInverse(const Matrix& _inverse, const double _tolerance,
+                         const int _maxSteps = 10) const;
 
  private:
+    typedef std::vector<double, AlignedAllocator<double, kAlignment>> Buffer;
+
+    static int strideFor(const int _cols);
+    // Changes the shape keeping the elements that are still inside.
+    void reshape(const int _rows, const int _cols);
+
     int rows;
     int cols;
-    std::vector<std::vector<double>> data;
+    int stride;
+    Buffer data;
+    mutable std::shared_ptr<const LuDecomposition> factors;
 };
 
 #endif  // MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_OPERATIONS_H_
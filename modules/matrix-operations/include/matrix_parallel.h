@@ -0,0 +1,41 @@
+// Copyright 2020 Sokolov Andrey
+
+#ifndef MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_PARALLEL_H_
+#define MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_PARALLEL_H_
+
+#include <algorithm>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+// Number of threads to use: 0 means all cores.
+inline unsigned resolveThreads(const unsigned _threads) {
+    if (_threads != 0) {
+        return _threads;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls _body(part) for part in [0, _parts) on up to _threads threads, the
+// calling one included. Every part runs exactly once, so the result does not
+// depend on the number of threads when the parts write disjoint data.
+template <typename Body>
+void parallelFor(const int _parts, const unsigned _threads, Body _body) {
+    const int count = std::max(1, std::min(_parts,
+        static_cast<int>(resolveThreads(_threads))));
+    std::vector<std::thread> workers;
+    for (int tdx{1}; tdx < count; ++tdx) {
+        workers.push_back(std::thread([&_body, _parts, count, tdx] {
+            for (int part{tdx}; part < _parts; part += count) {
+                _body(part);
+            }
+        }));
+    }
+    for (int part{0}; part < _parts; part += count) {
+        _body(part);
+    }
+    for (size_t tdx{0}; tdx < workers.size(); ++tdx) {
+        workers[tdx].join();
+    }
+}
+
+#endif  // MODULES_MATRIX_OPERATIONS_INCLUDE_MATRIX_PARALLEL_H_
@@ -0,0 +1,277 @@
+// Copyright 2020 Sokolov Andrey
+#include <vector>
+#include <algorithm>
+#include <atomic>  // NOLINT(build/c++11)
+#include "include/matrix_gemm.h"
+#include "include/matrix_parallel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATRIX_GEMM_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Register block of the kernel: kMr rows by kNr columns of the result.
+const int kMr = 6;
+const int kNr = 8;
+// Cache blocks: a kMc x kKc panel of a stays in L2, a kKc x kNr sliver of b
+// in L1, and the kKc x kNc panel of b in L3.
+const int kMc = 72;
+const int kKc = 256;
+const int kNc = 2048;
+// Smaller products are not worth starting threads for.
+const double kMinParallelFlops = 2.0 * 96 * 96 * 96;
+
+typedef std::vector<double, AlignedAllocator<double, Matrix::kAlignment>>
+    Panel;
+typedef void (*Kernel)(int, const double*, const double*, double*, int,
+                       int, int);
+
+// Copies _a into slivers of kMr rows stored column by column, so that the
+// kernel reads it sequentially. Rows past the end are zero.
+void packA(const ConstMatrixView& _a, double* _out) {
+    for (int sdx{0}; sdx < _a.getRows(); sdx += kMr) {
+        int rowsIn = std::min(kMr, _a.getRows() - sdx);
+        for (int pdx{0}; pdx < _a.getCols(); ++pdx) {
+            for (int idx{0}; idx < rowsIn; ++idx) {
+                *_out++ = _a(sdx + idx, pdx);
+            }
+            for (int idx{rowsIn}; idx < kMr; ++idx) {
+                *_out++ = 0.0;
+            }
+        }
+    }
+}
+
+// Copies _b into slivers of kNr columns stored row by row.
+void packB(const ConstMatrixView& _b, double* _out) {
+    for (int sdx{0}; sdx < _b.getCols(); sdx += kNr) {
+        int colsIn = std::min(kNr, _b.getCols() - sdx);
+        for (int pdx{0}; pdx < _b.getRows(); ++pdx) {
+            const double* row = _b.rowPtr(pdx) + sdx;
+            std::copy(row, row + colsIn, _out);
+            std::fill(_out + colsIn, _out + kNr, 0.0);
+            _out += kNr;
+        }
+    }
+}
+
+// Adds the _rows x _cols corner of a full kMr x kNr block to _c.
+void addBlock(const double* _block, double* _c, int _ldc,
+              int _rows, int _cols) {
+    for (int idx{0}; idx < _rows; ++idx) {
+        for (int jdx{0}; jdx < _cols; ++jdx) {
+            _c[idx * _ldc + jdx] += _block[idx * kNr + jdx];
+        }
+    }
+}
+
+void kernelPortable(int _k, const double* _a, const double* _b, double* _c,
+                    int _ldc, int _rows, int _cols) {
+    double acc[kMr * kNr] = {};
+    for (int pdx{0}; pdx < _k; ++pdx) {
+        const double* a = _a + pdx * kMr;
+        const double* b = _b + pdx * kNr;
+        for (int idx{0}; idx < kMr; ++idx) {
+            for (int jdx{0}; jdx < kNr; ++jdx) {
+                acc[idx * kNr + jdx] += a[idx] * b[jdx];
+            }
+        }
+    }
+    addBlock(acc, _c, _ldc, _rows, _cols);
+}
+
+#ifdef MATRIX_GEMM_AVX2
+bool cpuHasAvx2Fma() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+// The 6 x 8 block lives in twelve ymm registers; every step broadcasts one
+// element of a sliver of _a and multiplies it by two vectors of _b.
+__attribute__((target("avx2,fma")))
+void kernelAvx2(int _k, const double* _a, const double* _b, double* _c,
+                int _ldc, int _rows, int _cols) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+    for (int pdx{0}; pdx < _k; ++pdx) {
+        const __m256d b0 = _mm256_load_pd(_b);
+        const __m256d b1 = _mm256_load_pd(_b + 4);
+        __m256d a = _mm256_broadcast_sd(_a);
+        c00 = _mm256_fmadd_pd(a, b0, c00);
+        c01 = _mm256_fmadd_pd(a, b1, c01);
+        a = _mm256_broadcast_sd(_a + 1);
+        c10 = _mm256_fmadd_pd(a, b0, c10);
+        c11 = _mm256_fmadd_pd(a, b1, c11);
+        a = _mm256_broadcast_sd(_a + 2);
+        c20 = _mm256_fmadd_pd(a, b0, c20);
+        c21 = _mm256_fmadd_pd(a, b1, c21);
+        a = _mm256_broadcast_sd(_a + 3);
+        c30 = _mm256_fmadd_pd(a, b0, c30);
+        c31 = _mm256_fmadd_pd(a, b1, c31);
+        a = _mm256_broadcast_sd(_a + 4);
+        c40 = _mm256_fmadd_pd(a, b0, c40);
+        c41 = _mm256_fmadd_pd(a, b1, c41);
+        a = _mm256_broadcast_sd(_a + 5);
+        c50 = _mm256_fmadd_pd(a, b0, c50);
+        c51 = _mm256_fmadd_pd(a, b1, c51);
+        _a += kMr;
+        _b += kNr;
+    }
+    const __m256d acc[kMr][2] = { {c00, c01}, {c10, c11}, {c20, c21},
+                                  {c30, c31}, {c40, c41}, {c50, c51} };
+    if (_rows == kMr && _cols == kNr) {
+        for (int idx{0}; idx < kMr; ++idx) {
+            double* c = _c + idx * _ldc;
+            _mm256_storeu_pd(c, _mm256_add_pd(_mm256_loadu_pd(c),
+                                              acc[idx][0]));
+            _mm256_storeu_pd(c + 4, _mm256_add_pd(_mm256_loadu_pd(c + 4),
+                                                  acc[idx][1]));
+        }
+        return;
+    }
+    double block[kMr * kNr];
+    for (int idx{0}; idx < kMr; ++idx) {
+        _mm256_storeu_pd(block + idx * kNr, acc[idx][0]);
+        _mm256_storeu_pd(block + idx * kNr + 4, acc[idx][1]);
+    }
+    addBlock(block, _c, _ldc, _rows, _cols);
+}
+#endif
+
+Kernel selectKernel() {
+#ifdef MATRIX_GEMM_AVX2
+    if (cpuHasAvx2Fma()) {
+        return kernelAvx2;
+    }
+#endif
+    return kernelPortable;
+}
+
+std::atomic<Kernel>& kernel() {
+    static std::atomic<Kernel> selected(selectKernel());
+    return selected;
+}
+
+}  // namespace
+
+bool gemmUsesSimd() {
+    return kernel() != kernelPortable;
+}
+
+void gemmEnableSimd(const bool _enable) {
+    kernel() = _enable ? selectKernel() : kernelPortable;
+}
+
+namespace {
+
+void gemmSerial(const ConstMatrixView& _a, const ConstMatrixView& _b,
+                const MatrixView& _c, const Kernel run) {
+    const int m = _c.getRows();
+    const int n = _c.getCols();
+    const int k = _a.getCols();
+    if (m == 0 || n == 0 || k == 0) {
+        return;
+    }
+    const int kcMax = std::min(kKc, k);
+    Panel aPack(static_cast<std::size_t>(
+        (std::min(kMc, m) + kMr - 1) / kMr * kMr) * kcMax);
+    Panel bPack(static_cast<std::size_t>(
+        (std::min(kNc, n) + kNr - 1) / kNr * kNr) * kcMax);
+    const int ldc = _c.getStride();
+
+    for (int jc{0}; jc < n; jc += kNc) {
+        const int nc = std::min(kNc, n - jc);
+        for (int pc{0}; pc < k; pc += kKc) {
+            const int kc = std::min(kKc, k - pc);
+            packB(_b.block(pc, jc, kc, nc), bPack.data());
+            for (int ic{0}; ic < m; ic += kMc) {
+                const int mc = std::min(kMc, m - ic);
+                packA(_a.block(ic, pc, mc, kc), aPack.data());
+                for (int jr{0}; jr < nc; jr += kNr) {
+                    for (int ir{0}; ir < mc; ir += kMr) {
+                        run(kc, aPack.data() + ir * kc,
+                            bPack.data() + jr * kc,
+                            _c.rowPtr(ic + ir) + jc + jr, ldc,
+                            std::min(kMr, mc - ir), std::min(kNr, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Start of part _part of _size split into _parts pieces of whole _step.
+int splitPoint(const int _size, const int _parts, const int _part,
+               const int _step) {
+    if (_part == _parts) {
+        return _size;
+    }
+    const int steps = (_size + _step - 1) / _step;
+    return std::min(_size, steps * _part / _parts * _step);
+}
+
+}  // namespace
+
+void gemm(const ConstMatrixView& _a, const ConstMatrixView& _b,
+          const MatrixView& _c, const unsigned _threads) {
+    const int m = _c.getRows();
+    const int n = _c.getCols();
+    const int k = _a.getCols();
+    if (_a.getRows() != m || _b.getRows() != k || _b.getCols() != n) {
+        throw "Matrix sizes do not match";
+    }
+    const Kernel run = kernel();
+    const unsigned threads = resolveThreads(_threads);
+    if (threads == 1 || 2.0 * m * n * k < kMinParallelFlops) {
+        gemmSerial(_a, _b, _c, run);
+        return;
+    }
+
+    // A grid of rowParts x colParts tiles, one per thread. Every thread
+    // packs the rows of _a and the columns of _b of its tile, so the grid
+    // with the smallest tile perimeter is the cheapest.
+    const int rowSteps = (m + kMr - 1) / kMr;
+    const int colSteps = (n + kNr - 1) / kNr;
+    int rowParts = 1;
+    int colParts = 1;
+    double bestCost = -1.0;
+    for (int rdx{1}; rdx <= static_cast<int>(threads); ++rdx) {
+        const int cdx = static_cast<int>(threads) / rdx;
+        if (rdx > rowSteps || rdx * cdx != static_cast<int>(threads) ||
+            cdx > colSteps) {
+            continue;
+        }
+        const double cost = static_cast<double>(m) / rdx +
+                            static_cast<double>(n) / cdx;
+        if (bestCost < 0.0 || cost < bestCost) {
+            bestCost = cost;
+            rowParts = rdx;
+            colParts = cdx;
+        }
+    }
+    if (bestCost < 0.0) {
+        rowParts = std::min(rowSteps, static_cast<int>(threads));
+    }
+
+    // Each element of _c is computed by one tile with the same order of
+    // additions as gemmSerial, so the result does not depend on threads.
+    parallelFor(rowParts * colParts, threads,
+                [&_a, &_b, &_c, run, rowParts, colParts, m, n, k](int part) {
+        const int rdx = part / colParts;
+        const int cdx = part % colParts;
+        const int rowBegin = splitPoint(m, rowParts, rdx, kMr);
+        const int rowEnd = splitPoint(m, rowParts, rdx + 1, kMr);
+        const int colBegin = splitPoint(n, colParts, cdx, kNr);
+        const int colEnd = splitPoint(n, colParts, cdx + 1, kNr);
+        gemmSerial(_a.block(rowBegin, 0, rowEnd - rowBegin, k),
+                   _b.block(0, colBegin, k, colEnd - colBegin),
+                   _c.block(rowBegin, colBegin, rowEnd - rowBegin,
+                            colEnd - colBegin), run);
+    });
+}
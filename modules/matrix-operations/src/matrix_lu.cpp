@@ -0,0 +1,273 @@
+// Copyright 2020 Sokolov Andrey
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "include/matrix_lu.h"
+#include "include/matrix_gemm.h"
+
+namespace {
+
+// Columns factored at once before the trailing update.
+const int kPanel = 64;
+
+}  // namespace
+
+LuDecomposition::LuDecomposition(const ConstMatrixView& _matrix)
+    : lu(_matrix), pivots(_matrix.getRows()), norm(0.0), oddSwaps(false),
+      singular(false) {
+    if (_matrix.getRows() != _matrix.getCols()) {
+        throw "Matrix is not square";
+    }
+    const int size = lu.getRows();
+
+    std::vector<double> colSums(size, 0.0);
+    for (int idx{0}; idx < size; ++idx) {
+        const double* row = lu.rowPtr(idx);
+        for (int jdx{0}; jdx < size; ++jdx) {
+            colSums[jdx] += std::fabs(row[jdx]);
+        }
+    }
+    for (int jdx{0}; jdx < size; ++jdx) {
+        norm = std::max(norm, colSums[jdx]);
+    }
+
+    for (int k0{0}; k0 < size; k0 += kPanel) {
+        const int k1 = std::min(size, k0 + kPanel);
+
+        // Unblocked elimination inside the panel. Rows are swapped whole,
+        // so the parts left and right of the panel follow the pivots.
+        for (int jdx{k0}; jdx < k1; ++jdx) {
+            int pivot = jdx;
+            for (int idx{jdx + 1}; idx < size; ++idx) {
+                if (std::fabs(lu(idx, jdx)) > std::fabs(lu(pivot, jdx))) {
+                    pivot = idx;
+                }
+            }
+            pivots[jdx] = pivot;
+            if (pivot != jdx) {
+                std::swap_ranges(lu.rowPtr(jdx), lu.rowPtr(jdx) + size,
+                                 lu.rowPtr(pivot));
+                oddSwaps = !oddSwaps;
+            }
+            const double diag = lu(jdx, jdx);
+            if (diag == 0.0) {
+                singular = true;
+                continue;
+            }
+            const double* top = lu.rowPtr(jdx);
+            for (int idx{jdx + 1}; idx < size; ++idx) {
+                double* row = lu.rowPtr(idx);
+                const double factor = row[jdx] /= diag;
+                for (int cdx{jdx + 1}; cdx < k1; ++cdx) {
+                    row[cdx] -= factor * top[cdx];
+                }
+            }
+        }
+        if (k1 == size) {
+            break;
+        }
+
+        // U12 = L11^-1 * A12.
+        for (int jdx{k0}; jdx < k1; ++jdx) {
+            const double* top = lu.rowPtr(jdx);
+            for (int idx{jdx + 1}; idx < k1; ++idx) {
+                double* row = lu.rowPtr(idx);
+                const double factor = row[jdx];
+                for (int cdx{k1}; cdx < size; ++cdx) {
+                    row[cdx] -= factor * top[cdx];
+                }
+            }
+        }
+
+        // A22 -= L21 * U12.
+        Matrix negL21 = Matrix(lu.block(k1, k0, size - k1, k1 - k0)) * -1.0;
+        gemm(negL21.view(), lu.block(k0, k1, k1 - k0, size - k1),
+             lu.block(k1, k1, size - k1, size - k1), Matrix::getThreads());
+    }
+}
+
+int LuDecomposition::getSize() const {
+    return lu.getRows();
+}
+
+const Matrix& LuDecomposition::getFactors() const {
+    return lu;
+}
+
+const std::vector<int>& LuDecomposition::getPivots() const {
+    return pivots;
+}
+
+bool LuDecomposition::isSingular() const {
+    return singular;
+}
+
+double LuDecomposition::determinant() const {
+    if (singular) {
+        return 0.0;
+    }
+    double result = oddSwaps ? -1.0 : 1.0;
+    for (int idx{0}; idx < lu.getRows(); ++idx) {
+        result *= lu(idx, idx);
+    }
+    return result;
+}
+
+Matrix LuDecomposition::solve(const Matrix& _b) const {
+    const int size = lu.getRows();
+    if (_b.getRows() != size) {
+        throw "Matrix sizes do not match";
+    }
+    if (singular) {
+        throw "Matrix is singular";
+    }
+    Matrix result(_b);
+    const int cols = result.getCols();
+
+    // Every step works on whole rows of the right-hand sides, so all of
+    // them are solved in one pass over the factors.
+    for (int idx{0}; idx < size; ++idx) {
+        if (pivots[idx] != idx) {
+            std::swap_ranges(result.rowPtr(idx), result.rowPtr(idx) + cols,
+                             result.rowPtr(pivots[idx]));
+        }
+    }
+    for (int idx{1}; idx < size; ++idx) {
+        double* row = result.rowPtr(idx);
+        for (int jdx{0}; jdx < idx; ++jdx) {
+            const double factor = lu(idx, jdx);
+            const double* above = result.rowPtr(jdx);
+            for (int cdx{0}; cdx < cols; ++cdx) {
+                row[cdx] -= factor * above[cdx];
+            }
+        }
+    }
+    for (int idx{size - 1}; idx >= 0; --idx) {
+        double* row = result.rowPtr(idx);
+        for (int jdx{idx + 1}; jdx < size; ++jdx) {
+            const double factor = lu(idx, jdx);
+            const double* below = result.rowPtr(jdx);
+            for (int cdx{0}; cdx < cols; ++cdx) {
+                row[cdx] -= factor * below[cdx];
+            }
+        }
+        const double diag = lu(idx, idx);
+        for (int cdx{0}; cdx < cols; ++cdx) {
+            row[cdx] /= diag;
+        }
+    }
+    return result;
+}
+
+std::vector<double> LuDecomposition::solve(
+    const std::vector<double>& _b) const {
+    Matrix column(static_cast<int>(_b.size()), 1);
+    for (int idx{0}; idx < column.getRows(); ++idx) {
+        column(idx, 0) = _b[idx];
+    }
+    Matrix result = solve(column);
+    std::vector<double> x(result.getRows());
+    for (int idx{0}; idx < result.getRows(); ++idx) {
+        x[idx] = result(idx, 0);
+    }
+    return x;
+}
+
+std::vector<double> LuDecomposition::solveTransposed(
+    const std::vector<double>& _b) const {
+    const int size = lu.getRows();
+    if (static_cast<int>(_b.size()) != size) {
+        throw "Matrix sizes do not match";
+    }
+    if (singular) {
+        throw "Matrix is singular";
+    }
+    // A^T = U^T * L^T * P: both triangles are walked along rows of lu.
+    std::vector<double> x(_b);
+    for (int jdx{0}; jdx < size; ++jdx) {
+        const double* row = lu.rowPtr(jdx);
+        x[jdx] /= row[jdx];
+        for (int idx{jdx + 1}; idx < size; ++idx) {
+            x[idx] -= row[idx] * x[jdx];
+        }
+    }
+    for (int jdx{size - 1}; jdx > 0; --jdx) {
+        const double* row = lu.rowPtr(jdx);
+        for (int idx{0}; idx < jdx; ++idx) {
+            x[idx] -= row[idx] * x[jdx];
+        }
+    }
+    for (int idx{size - 1}; idx >= 0; --idx) {
+        std::swap(x[idx], x[pivots[idx]]);
+    }
+    return x;
+}
+
+Matrix LuDecomposition::inverse() const {
+    const int size = lu.getRows();
+    Matrix identity(size, size);
+    for (int idx{0}; idx < size; ++idx) {
+        identity(idx, idx) = 1.0;
+    }
+    return solve(identity);
+}
+
+double LuDecomposition::conditionEstimate() const {
+    if (singular) {
+        return std::numeric_limits<double>::infinity();
+    }
+    const int size = lu.getRows();
+    if (size == 0) {
+        return 0.0;
+    }
+
+    // Hager: climb ||A^-1 x||_1 over the unit ball from its centre, moving
+    // to the vertex e_j that the gradient A^-T sign(A^-1 x) points to.
+    const int kMaxSteps = 5;
+    std::vector<double> x(size, 1.0 / size);
+    double estimate = 0.0;
+    for (int step{0}; step < kMaxSteps; ++step) {
+        std::vector<double> y = solve(x);
+        std::vector<double> signs(size);
+        double yNorm = 0.0;
+        for (int idx{0}; idx < size; ++idx) {
+            yNorm += std::fabs(y[idx]);
+            signs[idx] = y[idx] < 0.0 ? -1.0 : 1.0;
+        }
+        if (step > 0 && yNorm <= estimate) {
+            break;
+        }
+        estimate = yNorm;
+        std::vector<double> z = solveTransposed(signs);
+        int best = 0;
+        double zx = 0.0;
+        for (int idx{0}; idx < size; ++idx) {
+            zx += z[idx] * x[idx];
+            if (std::fabs(z[idx]) > std::fabs(z[best])) {
+                best = idx;
+            }
+        }
+        if (std::fabs(z[best]) <= zx) {
+            break;
+        }
+        std::fill(x.begin(), x.end(), 0.0);
+        x[best] = 1.0;
+    }
+
+    // Higham's extra test vector catches matrices that fool the climb.
+    std::vector<double> alternating(size);
+    for (int idx{0}; idx < size; ++idx) {
+        double sign = idx % 2 == 0 ? 1.0 : -1.0;
+        alternating[idx] = sign * (1.0 + (size > 1 ?
+            static_cast<double>(idx) / (size - 1) : 0.0));
+    }
+    std::vector<double> y = solve(alternating);
+    double yNorm = 0.0;
+    for (int idx{0}; idx < size; ++idx) {
+        yNorm += std::fabs(y[idx]);
+    }
+    estimate = std::max(estimate, 2.0 * yNorm / (3.0 * size));
+
+    return norm * estimate;
+}
@@ -1,31 +1,102 @@
 // Copyright 2020 Sokolov Andrey
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <memory>
+#include <atomic>  // NOLINT(build/c++11)
 #include "include/matrix_operations.h"
+#include "include/matrix_gemm.h"
+#include "include/matrix_lu.h"
+#include "include/matrix_parallel.h"
 
+namespace {
+
+// Elementwise loops over fewer elements stay on the calling thread.
+const double kMinParallelElements = 1 << 16;
+
+std::atomic<unsigned>& threadCount() {
+    static std::atomic<unsigned> count(1);
+    return count;
+}
+
+// Calls _body(row) for every row, splitting the rows into one band per
+// thread when the matrix is large enough.
+template <typename Body>
+void forEachRow(const int _rows, const int _cols, Body _body) {
+    const unsigned threads = resolveThreads(threadCount());
+    if (threads == 1 ||
+        static_cast<double>(_rows) * _cols < kMinParallelElements) {
+        for (int idx{0}; idx < _rows; ++idx) {
+            _body(idx);
+        }
+        return;
+    }
+    const int parts = std::min(_rows, static_cast<int>(threads));
+    parallelFor(parts, threads, [&_body, _rows, parts](int part) {
+        const int end = _rows / parts * (part + 1) +
+                        std::min(_rows % parts, part + 1);
+        for (int idx{_rows / parts * part + std::min(_rows % parts, part)};
+             idx < end; ++idx) {
+            _body(idx);
+        }
+    });
+}
+
+}  // namespace
+
+const std::size_t Matrix::kAlignment;
+
+void Matrix::setThreads(const unsigned _threads) {
+    threadCount() = _threads;
+}
+
+unsigned Matrix::getThreads() {
+    return threadCount();
+}
+
+int Matrix::strideFor(const int _cols) {
+    const int perLine = static_cast<int>(kAlignment / sizeof(double));
+    return (_cols + perLine - 1) / perLine * perLine;
+}
 
 Matrix::Matrix(const int _rows,
                const int _cols) : rows(_rows),
                                   cols(_cols),
-                                  data(_rows,
-                                       std::vector<double>(_cols, 0.0)) {}
+                                  stride(strideFor(_cols)),
+                                  data(static_cast<std::size_t>(_rows) *
+                                       stride, 0.0) {}
 
 Matrix::Matrix(const int                              _rows,
                const int                              _cols,
-               const std::vector<std::vector<double>> _data) : rows(_rows),
-                                                               cols(_cols),
-                                                               data(_data) {}
+               const std::vector<std::vector<double>> _data)
+    : Matrix(_rows, _cols) {
+    int dataRows = std::min(_rows, static_cast<int>(_data.size()));
+    for (int idx{0}; idx < dataRows; ++idx) {
+        int dataCols = std::min(_cols, static_cast<int>(_data[idx].size()));
+        std::copy(_data[idx].begin(), _data[idx].begin() + dataCols,
+                  rowPtr(idx));
+    }
+}
 
 Matrix::Matrix(const Matrix& _matrix) : rows(_matrix.rows),
                                         cols(_matrix.cols),
+                                        stride(_matrix.stride),
                                         data(_matrix.data) {}
 
+Matrix::Matrix(const ConstMatrixView& _view)
+    : Matrix(_view.getRows(), _view.getCols()) {
+    for (int idx{0}; idx < rows; ++idx) {
+        std::copy(_view.rowPtr(idx), _view.rowPtr(idx) + cols, rowPtr(idx));
+    }
+}
 
 Matrix& Matrix::operator=(const Matrix& _matrix) {
     if (this != &_matrix) {
-        rows = _matrix.getRows();
-        cols = _matrix.getCols();
-        data = _matrix.getData();
+        rows = _matrix.rows;
+        cols = _matrix.cols;
+        stride = _matrix.stride;
+        data = _matrix.data;
+        factors.reset();
     }
     return *this;
 }
@@ -38,71 +109,134 @@ int Matrix::getCols() const {
     return cols;
 }
 
+int Matrix::getStride() const {
+    return stride;
+}
+
 std::vector<std::vector<double>> Matrix::getData() const {
-    return data;
+    std::vector<std::vector<double>> result(rows);
+    for (int idx{0}; idx < rows; ++idx) {
+        result[idx].assign(rowPtr(idx), rowPtr(idx) + cols);
+    }
+    return result;
+}
+
+void Matrix::reshape(const int _rows, const int _cols) {
+    if (_cols == cols) {
+        data.resize(static_cast<std::size_t>(_rows) * stride, 0.0);
+        rows = _rows;
+        factors.reset();
+        return;
+    }
+    Matrix result(_rows, _cols);
+    int keepCols = std::min(cols, _cols);
+    for (int idx{0}; idx < std::min(rows, _rows); ++idx) {
+        std::copy(rowPtr(idx), rowPtr(idx) + keepCols, result.rowPtr(idx));
+    }
+    *this = result;
 }
 
 void Matrix::setRows(const int _rows) {
-    rows = _rows;
-    data.resize(rows);
+    reshape(_rows, cols);
 }
 
 void Matrix::setCols(const int _cols) {
-    cols = _cols;
-    for (int idx{0}; idx < rows; ++idx) {
-        data[idx].resize(cols);
-    }
+    reshape(rows, _cols);
 }
 
 void Matrix::setData(std::vector<std::vector<double>> _data) {
-    data = _data;
-    rows = data.size();
-    cols = data[0U].size();
+    *this = Matrix(_data.size(), _data[0U].size(), _data);
+}
+
+MatrixView Matrix::view() {
+    factors.reset();
+    return MatrixView(dataPtr(), rows, cols, stride);
+}
+
+ConstMatrixView Matrix::view() const {
+    return ConstMatrixView(dataPtr(), rows, cols, stride);
+}
+
+MatrixView Matrix::row(const int _row) {
+    return view().block(_row, 0, 1, cols);
+}
+
+ConstMatrixView Matrix::row(const int _row) const {
+    return view().block(_row, 0, 1, cols);
+}
+
+MatrixView Matrix::col(const int _col) {
+    return view().block(0, _col, rows, 1);
+}
+
+ConstMatrixView Matrix::col(const int _col) const {
+    return view().block(0, _col, rows, 1);
+}
+
+MatrixView Matrix::block(const int _row, const int _col,
+                         const int _rows, const int _cols) {
+    return view().block(_row, _col, _rows, _cols);
+}
+
+ConstMatrixView Matrix::block(const int _row, const int _col,
+                              const int _rows, const int _cols) const {
+    return view().block(_row, _col, _rows, _cols);
 }
 
 Matrix Matrix::operator+ (const Matrix& _matrix) const {
     Matrix result(rows, cols);
 
-    for (int idx{0}; idx < getRows(); ++idx) {
-        for (int jdx{0}; jdx < getCols(); ++jdx) {
-            result.data[idx][jdx] = data[idx][jdx] + _matrix.data[idx][jdx];
+    // Views are taken here so that the workers only touch the elements.
+    const ConstMatrixView lhs = view();
+    const ConstMatrixView rhs = _matrix.view();
+    const MatrixView out = result.view();
+    forEachRow(rows, cols, [lhs, rhs, out](int idx) {
+        const double* lhsRow = lhs.rowPtr(idx);
+        const double* rhsRow = rhs.rowPtr(idx);
+        double* outRow = out.rowPtr(idx);
+        for (int jdx{0}; jdx < out.getCols(); ++jdx) {
+            outRow[jdx] = lhsRow[jdx] + rhsRow[jdx];
         }
-    }
+    });
     return result;
 }
 
 Matrix Matrix::operator- (const Matrix& _matrix) const {
     Matrix result(rows, cols);
 
-    for (int idx{0}; idx < getRows(); ++idx) {
-        for (int jdx{0}; jdx < getCols(); ++jdx) {
-            result.data[idx][jdx] = data[idx][jdx] - _matrix.data[idx][jdx];
+    // Views are taken here so that the workers only touch the elements.
+    const ConstMatrixView lhs = view();
+    const ConstMatrixView rhs = _matrix.view();
+    const MatrixView out = result.view();
+    forEachRow(rows, cols, [lhs, rhs, out](int idx) {
+        const double* lhsRow = lhs.rowPtr(idx);
+        const double* rhsRow = rhs.rowPtr(idx);
+        double* outRow = out.rowPtr(idx);
+        for (int jdx{0}; jdx < out.getCols(); ++jdx) {
+            outRow[jdx] = lhsRow[jdx] - rhsRow[jdx];
         }
-    }
+    });
     return result;
 }
 
 Matrix Matrix::operator* (const double& _scalar) const {
-    Matrix result(rows, cols, data);
-
-    for (int idx{0}; idx < rows; ++idx) {
-        for (int jdx{0}; jdx < cols; ++jdx) {
-            result.data[idx][jdx] *= _scalar;
+    Matrix result(*this);
+
+    const MatrixView out = result.view();
+    const double scalar = _scalar;
+    forEachRow(rows, cols, [out, scalar](int idx) {
+        double* outRow = out.rowPtr(idx);
+        for (int jdx{0}; jdx < out.getCols(); ++jdx) {
+            outRow[jdx] *= scalar;
         }
-    }
+    });
     return result;
 }
 
 Matrix Matrix::operator*(const Matrix& _matrix) const {
     Matrix res(rows, _matrix.cols);
 
-    for (int idx{0}; idx < rows; ++idx) {
-        for (int jdx{0}; jdx < _matrix.cols; ++jdx) {
-            for (int kdx{0}; kdx < cols; ++kdx) {
-                res.data[idx][jdx] += data[idx][kdx] * _matrix.data[kdx][jdx];
-            }
-        }
-    }
+    gemm(view(), _matrix.view(), res.view(), threadCount());
     return res;
 }
 
@@ -112,11 +246,10 @@ bool Matrix::operator== (const Matrix& _matrix) const {
         return false;
     }
 
-    for (int idx{0}; idx < getRows(); ++idx) {
-        for (int jdx{0}; jdx < getCols(); ++jdx) {
-            if (data[idx][jdx] != _matrix.data[idx][jdx]) {
-                return false;
-            }
+    for (int idx{0}; idx < rows; ++idx) {
+        if (!std::equal(rowPtr(idx), rowPtr(idx) + cols,
+                        _matrix.rowPtr(idx))) {
+            return false;
         }
     }
     return true;
@@ -126,78 +259,98 @@ bool Matrix::operator!= (const Matrix& _matrix) const {
     return !(*this == _matrix);
 }
 
-double Matrix::determinant() {
-    double sum12;
-    double sum22;
-    sum12 = 0.0;
-    sum22 = 0.0;
-    for (int idx{0}; idx < rows; idx++) {
-        double sum11 = 1.0;
-        double sum21 = 1.0;
-        int l = 2 * rows - 1 - idx;
-        for (int jdx{0}; jdx < rows; jdx++) {
-            sum21 *= data[jdx][l-- % rows];
-            sum11 *= data[jdx][(jdx + idx) % (rows)];
+std::shared_ptr<const LuDecomposition> Matrix::factorize() const {
+    // Concurrent calls may both factor the matrix; the first one to finish
+    // is kept and the other result is dropped.
+    std::shared_ptr<const LuDecomposition> cached = std::atomic_load(&factors);
+    if (!cached) {
+        std::shared_ptr<const LuDecomposition> made =
+            std::make_shared<const LuDecomposition>(view());
+        if (std::atomic_compare_exchange_strong(&factors, &cached, made)) {
+            cached = made;
         }
-        sum22 += sum21;
-        sum12 += sum11;
     }
-    return sum12 - sum22;
+    return cached;
 }
 
-Matrix Matrix::transpose() {
-    Matrix result(rows, cols, data);
+double Matrix::determinant() const {
+    return factorize()->determinant();
+}
+
+Matrix Matrix::solve(const Matrix& _b) const {
+    return factorize()->solve(_b);
+}
 
-    for (int idx{0}; idx < getRows()-1; ++idx) {
-        for (int jdx{idx + 1}; jdx < getCols(); ++jdx) {
-            std::swap(result.data[jdx][idx], result.data[idx][jdx]);
+std::vector<double> Matrix::solve(const std::vector<double>& _b) const {
+    return factorize()->solve(_b);
+}
+
+Matrix Matrix::transpose() const {
+    Matrix result(cols, rows);
+
+    for (int idx{0}; idx < rows; ++idx) {
+        const double* in = rowPtr(idx);
+        for (int jdx{0}; jdx < cols; ++jdx) {
+            result(jdx, idx) = in[jdx];
         }
     }
     return result;
 }
 
-Matrix Matrix::takeInverseMatrix() {
-    if (this->determinant() == 0) {
+Matrix Matrix::takeInverseMatrix() const {
+    std::shared_ptr<const LuDecomposition> lu = factorize();
+    if (lu->isSingular()) {
         throw "Determinant are equal zero";
     }
+    return lu->inverse();
+}
 
-    int size{rows};
-
-    Matrix A(size, size, data);
-    Matrix A0(size, size, data);
-    Matrix E2(size, size);
-    for (int idx{0}; idx < size; idx++) {
-        E2.data[idx][idx] = 2;
-    }
+double Matrix::conditionNumber() const {
+    return factorize()->conditionEstimate();
+}
 
-    double N1;
-    double Ninf;
-    N1   = 0.0;
-    Ninf = 0.0;
-    for (int row{0}; row < size; ++row) {
-        double colsum;
-        double rowsum;
-        colsum = 0.0;
-        rowsum = 0.0;
-        for (int col{0}; col < size; ++col) {
-            rowsum += fabs(A0.data[row][col]);
-            colsum += fabs(A0.data[col][row]);
+namespace {
+
+// _residual = I - _a * _x; returns its 1-norm.
+double inverseResidual(const Matrix& _a, const Matrix& _x,
+                       Matrix* _residual) {
+    const int size = _a.getRows();
+    Matrix product(size, size);
+    gemm(_a.view(), _x.view(), product.view(), Matrix::getThreads());
+    std::vector<double> colSums(size, 0.0);
+    for (int idx{0}; idx < size; ++idx) {
+        const double* in = product.rowPtr(idx);
+        double* out = _residual->rowPtr(idx);
+        for (int jdx{0}; jdx < size; ++jdx) {
+            out[jdx] = (idx == jdx ? 1.0 : 0.0) - in[jdx];
+            colSums[jdx] += std::fabs(out[jdx]);
         }
-        N1 = std::max(colsum, N1);
-        Ninf = std::max(rowsum, Ninf);
     }
+    return size == 0 ? 0.0 : *std::max_element(colSums.begin(),
+                                                colSums.end());
+}
 
-    A0 = A0.transpose();
-    A0 = A0 * (1 / (N1 * Ninf));
+}  // namespace
 
-    Matrix inv{A0};
-    while (fabs((A * inv).determinant() - 1) >= 0.001) {
-        Matrix prev{inv};
-        inv = A * prev;
-        inv = inv * -1;
-        inv = inv + E2;
-        inv = prev * inv;
+Matrix Matrix::refineInverse(const Matrix& _inverse, const double _tolerance,
+                             const int _maxSteps) const {
+    if (rows != cols || _inverse.rows != rows || _inverse.cols != cols) {
+        throw "Matrix sizes do not match";
+    }
+    Matrix inv(_inverse);
+    Matrix residual(rows, cols);
+    double norm = inverseResidual(*this, inv, &residual);
+    for (int step{0}; step < _maxSteps && norm > _tolerance; ++step) {
+        Matrix next(inv);
+        gemm(inv.view(), residual.view(), next.view(), getThreads());
+        Matrix nextResidual(rows, cols);
+        double nextNorm = inverseResidual(*this, next, &nextResidual);
+        if (nextNorm >= norm) {
+            break;
+        }
+        inv = next;
+        residual = nextResidual;
+        norm = nextNorm;
     }
-
     return inv;
 }
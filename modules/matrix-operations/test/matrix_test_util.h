@@ -0,0 +1,37 @@
+// Copyright 2020 Sokolov Andrey
+
+#ifndef MODULES_MATRIX_OPERATIONS_TEST_MATRIX_TEST_UTIL_H_
+#define MODULES_MATRIX_OPERATIONS_TEST_MATRIX_TEST_UTIL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "include/matrix_operations.h"
+
+// Elements uniform in [-1, 1), the same for the same seed.
+inline Matrix randomMatrix(const int _rows, const int _cols,
+                           const unsigned _seed) {
+    std::mt19937 gen(_seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Matrix result(_rows, _cols);
+    for (int idx{0}; idx < _rows; ++idx) {
+        for (int jdx{0}; jdx < _cols; ++jdx) {
+            result(idx, jdx) = dist(gen);
+        }
+    }
+    return result;
+}
+
+// Largest absolute difference of two matrices of the same size.
+inline double maxDifference(const Matrix& _a, const Matrix& _b) {
+    double result = 0.0;
+    for (int idx{0}; idx < _a.getRows(); ++idx) {
+        for (int jdx{0}; jdx < _a.getCols(); ++jdx) {
+            result = std::max(result, std::fabs(_a(idx, jdx) - _b(idx, jdx)));
+        }
+    }
+    return result;
+}
+
+#endif  // MODULES_MATRIX_OPERATIONS_TEST_MATRIX_TEST_UTIL_H_
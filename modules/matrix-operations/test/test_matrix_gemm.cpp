@@ -0,0 +1,157 @@
+// Copyright 2020 Sokolov Andrey
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "include/matrix_gemm.h"
+#include "include/matrix_operations.h"
+#include "test/matrix_test_util.h"
+
+namespace {
+
+Matrix naiveProduct(const ConstMatrixView& _a, const ConstMatrixView& _b) {
+    Matrix result(_a.getRows(), _b.getCols());
+    for (int idx{0}; idx < _a.getRows(); ++idx) {
+        for (int jdx{0}; jdx < _b.getCols(); ++jdx) {
+            for (int kdx{0}; kdx < _a.getCols(); ++kdx) {
+                result(idx, jdx) += _a(idx, kdx) * _b(kdx, jdx);
+            }
+        }
+    }
+    return result;
+}
+
+void expectNear(const Matrix& _expect, const Matrix& _actual) {
+    ASSERT_EQ(_expect.getRows(), _actual.getRows());
+    ASSERT_EQ(_expect.getCols(), _actual.getCols());
+    for (int idx{0}; idx < _expect.getRows(); ++idx) {
+        for (int jdx{0}; jdx < _expect.getCols(); ++jdx) {
+            ASSERT_NEAR(_expect(idx, jdx), _actual(idx, jdx), 1e-10)
+                << idx << ", " << jdx;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(MatrixGemmTest, Product_Matches_Naive_For_Odd_Sizes) {
+    // Arrange
+    const int sizes[][3] = { {1, 1, 1}, {7, 13, 9}, {6, 8, 8},
+                             {75, 300, 101}, {130, 17, 2051} };
+
+    for (const auto& size : sizes) {
+        Matrix a = randomMatrix(size[0], size[1], 1);
+        Matrix b = randomMatrix(size[1], size[2], 2);
+
+        // Act
+        Matrix result = a * b;
+
+        // Assert
+        expectNear(naiveProduct(a.view(), b.view()), result);
+    }
+}
+
+TEST(MatrixGemmTest, Portable_Kernel_Matches_Naive) {
+    // Arrange
+    Matrix a = randomMatrix(50, 70, 6);
+    Matrix b = randomMatrix(70, 33, 7);
+    bool simd = gemmUsesSimd();
+
+    // Act
+    gemmEnableSimd(false);
+    Matrix result = a * b;
+    gemmEnableSimd(simd);
+
+    // Assert
+    expectNear(naiveProduct(a.view(), b.view()), result);
+}
+
+TEST(MatrixGemmTest, Gemm_Accumulates_Into_Block) {
+    // Arrange
+    Matrix a = randomMatrix(40, 50, 3);
+    Matrix b = randomMatrix(50, 60, 4);
+    Matrix c = randomMatrix(30, 20, 5);
+    Matrix expect(c);
+    Matrix product = naiveProduct(a.block(5, 10, 12, 9),
+                                  b.block(20, 30, 9, 7));
+    for (int idx{0}; idx < 12; ++idx) {
+        for (int jdx{0}; jdx < 7; ++jdx) {
+            expect(idx + 3, jdx + 2) += product(idx, jdx);
+        }
+    }
+
+    // Act
+    gemm(a.block(5, 10, 12, 9), b.block(20, 30, 9, 7),
+         c.block(3, 2, 12, 7));
+
+    // Assert
+    expectNear(expect, c);
+}
+
+TEST(MatrixGemmTest, Test_Throw_Size_Mismatch) {
+    // Arrange
+    Matrix a(3, 4);
+    Matrix b(5, 2);
+    Matrix c(3, 2);
+
+    // Act & Assert
+    ASSERT_ANY_THROW(gemm(a.view(), b.view(), c.view()));
+}
+
+TEST(MatrixGemmTest, Threaded_Product_Is_Bitwise_Identical) {
+    // Arrange
+    Matrix a = randomMatrix(203, 157, 8);
+    Matrix b = randomMatrix(157, 171, 9);
+    Matrix expect(203, 171);
+    gemm(a.view(), b.view(), expect.view(), 1);
+
+    for (unsigned threads : {2u, 3u, 4u, 7u, 0u}) {
+        Matrix result(203, 171);
+
+        // Act
+        gemm(a.view(), b.view(), result.view(), threads);
+
+        // Assert
+        EXPECT_EQ(expect, result) << threads << " threads";
+    }
+}
+
+TEST(MatrixGemmTest, Threaded_Operators_Match_Serial) {
+    // Arrange
+    Matrix a = randomMatrix(300, 260, 10);
+    Matrix b = randomMatrix(300, 260, 11);
+    Matrix c = randomMatrix(260, 90, 12);
+    unsigned threads = Matrix::getThreads();
+    Matrix sum = a + b;
+    Matrix difference = a - b;
+    Matrix scaled = a * 0.75;
+    Matrix product = a * c;
+
+    // Act
+    Matrix::setThreads(4);
+    Matrix sum4 = a + b;
+    Matrix difference4 = a - b;
+    Matrix scaled4 = a * 0.75;
+    Matrix product4 = a * c;
+    Matrix::setThreads(threads);
+
+    // Assert
+    EXPECT_EQ(sum, sum4);
+    EXPECT_EQ(difference, difference4);
+    EXPECT_EQ(scaled, scaled4);
+    EXPECT_EQ(product, product4);
+}
+
+TEST(MatrixGemmTest, Can_Set_Threads) {
+    // Arrange
+    unsigned threads = Matrix::getThreads();
+
+    // Act
+    Matrix::setThreads(0);
+
+    // Assert
+    EXPECT_EQ(1u, threads);
+    EXPECT_EQ(0u, Matrix::getThreads());
+    Matrix::setThreads(threads);
+}
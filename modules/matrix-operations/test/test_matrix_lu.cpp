@@ -0,0 +1,354 @@
+// Copyright 2020 Sokolov Andrey
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "include/matrix_lu.h"
+#include "include/matrix_operations.h"
+#include "test/matrix_test_util.h"
+
+namespace {
+
+Matrix identity(const int _size) {
+    Matrix result(_size, _size);
+    for (int idx{0}; idx < _size; ++idx) {
+        result(idx, idx) = 1.0;
+    }
+    return result;
+}
+
+double norm1(const Matrix& _matrix) {
+    double result = 0.0;
+    for (int jdx{0}; jdx < _matrix.getCols(); ++jdx) {
+        double sum = 0.0;
+        for (int idx{0}; idx < _matrix.getRows(); ++idx) {
+            sum += std::fabs(_matrix(idx, jdx));
+        }
+        result = std::max(result, sum);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(MatrixLuTest, Can_Solve_System) {
+    // Arrange
+    std::vector<std::vector<double>> data{{ 2.0,  1.0, -1.0},
+                                          {-3.0, -1.0,  2.0},
+                                          {-2.0,  1.0,  2.0}};
+    Matrix matrix(3, 3, data);
+    std::vector<double> b{8.0, -11.0, -3.0};
+
+    // Act
+    std::vector<double> x = matrix.solve(b);
+
+    // Assert
+    ASSERT_EQ(3u, x.size());
+    EXPECT_NEAR(2.0, x[0], 1e-12);
+    EXPECT_NEAR(3.0, x[1], 1e-12);
+    EXPECT_NEAR(-1.0, x[2], 1e-12);
+}
+
+TEST(MatrixLuTest, Solves_Large_System_With_Many_Right_Hand_Sides) {
+    // Arrange
+    Matrix a = randomMatrix(203, 203, 1);
+    Matrix x = randomMatrix(203, 5, 2);
+    Matrix b = a * x;
+
+    // Act
+    Matrix result = a.solve(b);
+
+    // Assert
+    EXPECT_LT(maxDifference(x, result), 1e-9);
+}
+
+TEST(MatrixLuTest, Factors_Reproduce_Permuted_Matrix) {
+    // Arrange
+    Matrix a = randomMatrix(150, 150, 3);
+
+    // Act
+    LuDecomposition lu(a.view());
+
+    // Assert
+    const Matrix& factors = lu.getFactors();
+    Matrix lower(150, 150);
+    Matrix upper(150, 150);
+    for (int idx{0}; idx < 150; ++idx) {
+        lower(idx, idx) = 1.0;
+        for (int jdx{0}; jdx < 150; ++jdx) {
+            if (jdx < idx) {
+                lower(idx, jdx) = factors(idx, jdx);
+            } else {
+                upper(idx, jdx) = factors(idx, jdx);
+            }
+        }
+    }
+    Matrix permuted(a);
+    for (int idx{0}; idx < 150; ++idx) {
+        int pivot = lu.getPivots()[idx];
+        for (int jdx{0}; jdx < 150; ++jdx) {
+            std::swap(permuted(idx, jdx), permuted(pivot, jdx));
+        }
+    }
+    EXPECT_LT(maxDifference(permuted, lower * upper), 1e-12);
+}
+
+TEST(MatrixLuTest, Determinant_Of_Large_Triangular_Matrix) {
+    // Arrange
+    Matrix matrix = randomMatrix(100, 100, 4);
+    double expect = 1.0;
+    for (int idx{0}; idx < 100; ++idx) {
+        matrix(idx, idx) = 1.0 + idx % 3;
+        expect *= matrix(idx, idx);
+        for (int jdx{0}; jdx < idx; ++jdx) {
+            matrix(idx, jdx) = 0.0;
+        }
+    }
+    std::swap_ranges(matrix.rowPtr(0), matrix.rowPtr(0) + 100,
+                     matrix.rowPtr(99));
+
+    // Act
+    double result = matrix.determinant();
+
+    // Assert
+    EXPECT_NEAR(-expect, result, std::fabs(expect) * 1e-12);
+}
+
+TEST(MatrixLuTest, Singular_Matrix_Can_Not_Be_Solved) {
+    // Arrange
+    std::vector<std::vector<double>> data{{1.0, 2.0, 3.0},
+                                          {2.0, 4.0, 6.0},
+                                          {1.0, 0.0, 1.0}};
+    Matrix matrix(3, 3, data);
+
+    // Act
+    LuDecomposition lu(matrix.view());
+
+    // Assert
+    EXPECT_TRUE(lu.isSingular());
+    EXPECT_EQ(0.0, lu.determinant());
+    ASSERT_ANY_THROW(lu.solve(Matrix(3, 1)));
+}
+
+TEST(MatrixLuTest, Test_Throw_Not_Square_Or_Size_Mismatch) {
+    // Arrange
+    Matrix rectangular(3, 4);
+    Matrix square = randomMatrix(3, 3, 5);
+
+    // Act & Assert
+    ASSERT_ANY_THROW(LuDecomposition lu(rectangular.view()));
+    ASSERT_ANY_THROW(square.solve(Matrix(4, 1)));
+}
+
+TEST(MatrixLuTest, Factorization_Is_Kept_Until_Matrix_Changes) {
+    // Arrange
+    std::vector<std::vector<double>> data{{2.0, 1.0},
+                                          {1.0, 3.0}};
+    Matrix matrix(2, 2, data);
+    const Matrix& constMatrix = matrix;
+    const LuDecomposition* first = constMatrix.factorize().get();
+
+    // Act
+    const LuDecomposition* second = constMatrix.factorize().get();
+    double element = constMatrix(0, 0);
+    const LuDecomposition* third = constMatrix.factorize().get();
+    matrix.view()(0, 0) = 4.0;
+
+    // Assert
+    EXPECT_EQ(2.0, element);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first, third);
+    EXPECT_NEAR(11.0, constMatrix.determinant(), 1e-12);
+}
+
+TEST(MatrixLuTest, Element_Write_Drops_Factorization) {
+    // Arrange
+    std::vector<std::vector<double>> data{{2.0, 1.0},
+                                          {1.0, 3.0}};
+    Matrix matrix(2, 2, data);
+    EXPECT_NEAR(5.0, matrix.determinant(), 1e-12);
+
+    // Act
+    matrix(0, 0) = 4.0;
+    double determinant = matrix.determinant();
+    std::vector<double> x = matrix.solve(std::vector<double>{1.0, 1.0});
+    matrix.rowPtr(1)[1] = 1.0;
+
+    // Assert
+    EXPECT_NEAR(11.0, determinant, 1e-12);
+    EXPECT_NEAR(2.0 / 11.0, x[0], 1e-12);
+    EXPECT_NEAR(3.0 / 11.0, x[1], 1e-12);
+    EXPECT_NEAR(3.0, matrix.determinant(), 1e-12);
+}
+
+TEST(MatrixLuTest, Factorization_Outlives_Matrix_Change) {
+    // Arrange
+    std::vector<std::vector<double>> data{{2.0, 1.0},
+                                          {1.0, 3.0}};
+    Matrix matrix(2, 2, data);
+    std::shared_ptr<const LuDecomposition> lu = matrix.factorize();
+
+    // Act
+    matrix.row(0)(0, 0) = 4.0;
+
+    // Assert
+    EXPECT_NEAR(5.0, lu->determinant(), 1e-12);
+    EXPECT_NEAR(11.0, matrix.factorize()->determinant(), 1e-12);
+}
+
+TEST(MatrixLuTest, Copy_Does_Not_Share_Factorization) {
+    // Arrange
+    std::vector<std::vector<double>> data{{2.0, 1.0},
+                                          {1.0, 3.0}};
+    Matrix matrix(2, 2, data);
+    EXPECT_NEAR(5.0, matrix.determinant(), 1e-12);
+
+    // Act
+    Matrix copy(matrix);
+    copy(1, 1) = 1.0;
+    Matrix scaled = matrix * 2.0;
+
+    // Assert
+    EXPECT_NEAR(1.0, copy.determinant(), 1e-12);
+    EXPECT_NEAR(20.0, scaled.determinant(), 1e-12);
+    EXPECT_NEAR(5.0, matrix.determinant(), 1e-12);
+}
+
+TEST(MatrixLuTest, Inverse_Of_Large_Matrix) {
+    // Arrange
+    Matrix matrix = randomMatrix(170, 170, 6);
+
+    // Act
+    Matrix inverse = matrix.takeInverseMatrix();
+
+    // Assert
+    EXPECT_LT(maxDifference(identity(170), matrix * inverse), 1e-10);
+}
+
+TEST(MatrixLuTest, Can_Solve_Transposed_System) {
+    // Arrange
+    Matrix a = randomMatrix(90, 90, 7);
+    Matrix x = randomMatrix(90, 1, 8);
+    Matrix b = a.transpose() * x;
+    std::vector<double> column(90);
+    for (int idx{0}; idx < 90; ++idx) {
+        column[idx] = b(idx, 0);
+    }
+
+    // Act
+    std::vector<double> result = a.factorize()->solveTransposed(column);
+
+    // Assert
+    for (int idx{0}; idx < 90; ++idx) {
+        EXPECT_NEAR(x(idx, 0), result[idx], 1e-10);
+    }
+}
+
+TEST(MatrixLuTest, Condition_Of_Diagonal_Matrix_Is_Exact) {
+    // Arrange
+    std::vector<std::vector<double>> data{{4.0, 0.0,  0.0},
+                                          {0.0, 0.5,  0.0},
+                                          {0.0, 0.0, -1e-3}};
+    Matrix matrix(3, 3, data);
+
+    // Act
+    double condition = matrix.conditionNumber();
+
+    // Assert
+    EXPECT_NEAR(4000.0, condition, 1e-9);
+}
+
+TEST(MatrixLuTest, Condition_Estimate_Is_Close_To_Exact) {
+    // Arrange
+    Matrix matrix = randomMatrix(80, 80, 9);
+    double exact = norm1(matrix) * norm1(matrix.takeInverseMatrix());
+
+    // Act
+    double estimate = matrix.conditionNumber();
+
+    // Assert
+    EXPECT_LE(estimate, exact * (1.0 + 1e-9));
+    EXPECT_GE(estimate, exact / 3.0);
+}
+
+TEST(MatrixLuTest, Condition_Of_Singular_Matrix_Is_Infinite) {
+    // Arrange
+    std::vector<std::vector<double>> data{{1.0, 2.0},
+                                          {2.0, 4.0}};
+    Matrix matrix(2, 2, data);
+
+    // Act & Assert
+    EXPECT_TRUE(std::isinf(matrix.conditionNumber()));
+}
+
+TEST(MatrixLuTest, Refine_Inverse_Reduces_Residual) {
+    // Arrange
+    Matrix matrix = randomMatrix(60, 60, 10);
+    Matrix rough = matrix.takeInverseMatrix() * 1.01;
+
+    // Act
+    Matrix result = matrix.refineInverse(rough, 1e-12);
+
+    // Assert
+    EXPECT_LT(norm1(identity(60) - matrix * result), 1e-10);
+}
+
+TEST(MatrixLuTest, Refine_Inverse_Stops_At_Tolerance) {
+    // Arrange
+    Matrix matrix = randomMatrix(20, 20, 11);
+    Matrix rough = matrix.takeInverseMatrix() * 1.01;
+
+    // Act
+    Matrix result = matrix.refineInverse(rough, 1.0);
+
+    // Assert
+    EXPECT_EQ(rough, result);
+    ASSERT_ANY_THROW(matrix.refineInverse(Matrix(3, 3), 1e-12));
+}
+
+TEST(MatrixLuTest, Threaded_Operators_Keep_Factorization_Consistent) {
+    // Arrange
+    Matrix matrix = randomMatrix(400, 400, 12);
+    double determinant = matrix.determinant();
+    unsigned threads = Matrix::getThreads();
+
+    // Act
+    Matrix::setThreads(4);
+    Matrix scaled = matrix * 2.0;
+    Matrix sum = matrix + matrix;
+    Matrix::setThreads(threads);
+
+    // Assert
+    EXPECT_EQ(scaled, sum);
+    EXPECT_EQ(determinant, matrix.determinant());
+    EXPECT_LT(maxDifference(matrix.solve(sum) * 0.5,
+                            scaled.solve(sum)), 1e-9);
+}
+
+TEST(MatrixLuTest, Concurrent_Factorize_Gives_One_Result) {
+    // Arrange
+    const Matrix matrix = randomMatrix(120, 120, 13);
+    std::vector<double> results(4);
+
+    // Act
+    std::vector<std::thread> workers;
+    for (int idx{0}; idx < 4; ++idx) {
+        workers.push_back(std::thread([&matrix, &results, idx] {
+            results[idx] = matrix.determinant();
+        }));
+    }
+    for (size_t idx{0}; idx < workers.size(); ++idx) {
+        workers[idx].join();
+    }
+
+    // Assert
+    for (int idx{0}; idx < 4; ++idx) {
+        EXPECT_EQ(results[0], results[idx]);
+    }
+    EXPECT_EQ(results[0], matrix.determinant());
+}
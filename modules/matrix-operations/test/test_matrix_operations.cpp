@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <vector>
 
 #include "include/matrix_operations.h"
@@ -261,7 +262,7 @@ TEST(MatrixOperationsTest, Can_Take_Determinant) {
     double result{matrix.determinant()};
 
     // Assert
-    EXPECT_NEAR(result, 6080.576, 0.001);
+    EXPECT_NEAR(result, -122645.48, 0.001);
 }
 
 TEST(MatrixOperationsTest, Can_Take_Zero_Determinant) {
@@ -291,7 +292,7 @@ TEST(MatrixOperationsTest, Can_Take_Determinant_With_Zero_Diag) {
     double result = matrix.determinant();
 
     // Assert
-    EXPECT_EQ(result, 99.0);
+    EXPECT_EQ(result, -99.0);
 }
 
 TEST(MatrixOperationsTest, Can_Transpose_Matrix) {
@@ -427,3 +428,105 @@ TEST(MatrixOperationsTest, Different_Matrices_Not_Eqal) {
     // Act & Assert
     EXPECT_TRUE(matrixA != matrixB);
 }
+
+TEST(MatrixOperationsTest, Rows_Are_Aligned_And_Contiguous) {
+    // Arrange
+    Matrix matrix(5, 3);
+
+    // Act
+    const double* first = matrix.rowPtr(0);
+    const double* second = matrix.rowPtr(1);
+
+    // Assert
+    EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(first) %
+                  Matrix::kAlignment);
+    EXPECT_EQ(matrix.getStride(), second - first);
+    EXPECT_GE(matrix.getStride(), matrix.getCols());
+}
+
+TEST(MatrixOperationsTest, Can_Access_Elements_Without_Copying) {
+    // Arrange
+    std::vector<std::vector<double>> data{{1.0, 2.0, 3.0},
+                                          {4.0, 5.0, 6.0}};
+    Matrix matrix(2, 3, data);
+
+    // Act
+    matrix(1, 2) = 7.0;
+    matrix.rowPtr(0)[1] = 8.0;
+
+    // Assert
+    EXPECT_EQ(7.0, matrix.getData()[1U][2U]);
+    EXPECT_EQ(8.0, matrix(0, 1));
+}
+
+TEST(MatrixOperationsTest, Views_Share_Matrix_Storage) {
+    // Arrange
+    std::vector<std::vector<double>> data{{1.0, 2.0, 3.0},
+                                          {4.0, 5.0, 6.0},
+                                          {7.0, 8.0, 9.0}};
+    Matrix matrix(3, 3, data);
+
+    // Act
+    MatrixView column = matrix.col(1);
+    MatrixView block = matrix.block(1, 1, 2, 2);
+    column(0, 0) = -2.0;
+    block(1, 1) = -9.0;
+
+    // Assert
+    EXPECT_EQ(3, column.getRows());
+    EXPECT_EQ(1, column.getCols());
+    EXPECT_EQ(8.0, column(2, 0));
+    EXPECT_EQ(5.0, block(0, 0));
+    EXPECT_EQ(-2.0, matrix(0, 1));
+    EXPECT_EQ(-9.0, matrix(2, 2));
+    EXPECT_EQ(4.0, matrix.row(1)(0, 0));
+}
+
+TEST(MatrixOperationsTest, Can_Create_Matrix_From_View) {
+    // Arrange
+    std::vector<std::vector<double>> data{{1.0, 2.0, 3.0},
+                                          {4.0, 5.0, 6.0},
+                                          {7.0, 8.0, 9.0}};
+    const Matrix matrix(3, 3, data);
+    std::vector<std::vector<double>> goldData{{5.0, 6.0},
+                                              {8.0, 9.0}};
+
+    // Act
+    Matrix block(matrix.block(1, 1, 2, 2));
+
+    // Assert
+    EXPECT_EQ(Matrix(2, 2, goldData), block);
+}
+
+TEST(MatrixOperationsTest, Set_Cols_Keeps_Elements) {
+    // Arrange
+    std::vector<std::vector<double>> data{{1.0, 2.0, 3.0},
+                                          {4.0, 5.0, 6.0}};
+    Matrix matrix(2, 3, data);
+    std::vector<std::vector<double>> goldData{{1.0, 2.0},
+                                              {4.0, 5.0},
+                                              {0.0, 0.0}};
+
+    // Act
+    matrix.setCols(2);
+    matrix.setRows(3);
+
+    // Assert
+    EXPECT_EQ(goldData, matrix.getData());
+}
+
+TEST(MatrixOperationsTest, Can_Transpose_Rectangular_Matrix) {
+    // Arrange
+    std::vector<std::vector<double>> data{{1.0, 2.0, 3.0},
+                                          {4.0, 5.0, 6.0}};
+    std::vector<std::vector<double>> goldData{{1.0, 4.0},
+                                              {2.0, 5.0},
+                                              {3.0, 6.0}};
+    Matrix matrix(2, 3, data);
+
+    // Act
+    Matrix result = matrix.transpose();
+
+    // Assert
+    EXPECT_EQ(Matrix(3, 2, goldData), result);
+}
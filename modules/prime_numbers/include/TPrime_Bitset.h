@@ -0,0 +1,98 @@
+// Copyright 2020 Kuzhelev Anton
+
+#ifndef MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_BITSET_H_
+#define MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_BITSET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+
+// Dense set of all primes up to a limit, packed with the mod-30 wheel:
+// one byte holds the 8 residues coprime to 30 of a block of 30 numbers,
+// so the whole 32-bit range takes about 143 MB. A rank index with one
+// counter per 256 bytes makes Count(n) and Nth(k) cheap.
+// A set can be saved to a file and opened again by mapping the file into
+// memory, which costs nothing until the pages are touched. Copies share
+// the same read-only storage.
+class TPrime_Bitset {
+ public:
+    class const_iterator {
+     public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::uint64_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::uint64_t* pointer;
+        typedef std::uint64_t reference;
+
+        const_iterator() : set(nullptr), prime(0) {}
+        std::uint64_t operator*() const { return prime; }
+        const_iterator& operator++() {
+            prime = set->Next(prime);
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator old(*this);
+            ++*this;
+            return old;
+        }
+        bool operator==(const const_iterator& other) const {
+            return prime == other.prime;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return prime != other.prime;
+        }
+
+     private:
+        friend class TPrime_Bitset;
+        const_iterator(const TPrime_Bitset* set_, std::uint64_t prime_)
+            : set(set_), prime(prime_) {}
+
+        const TPrime_Bitset* set;
+        std::uint64_t prime;
+    };
+
+    explicit TPrime_Bitset(std::uint64_t limit, unsigned int threads_count = 1);
+
+    // Writes the bits and the rank index to path.
+    void Save(const std::string& path) const;
+    // Maps a file written by Save; throws if it is not a valid set.
+    static TPrime_Bitset Open(const std::string& path);
+
+    std::uint64_t Limit() const;
+    // Memory taken by the bits and the rank index.
+    std::size_t Bytes() const;
+
+    bool Contains(std::uint64_t n) const;
+    // Number of primes up to the limit.
+    std::uint64_t Count() const;
+    // Number of primes not greater than n (n <= limit).
+    std::uint64_t Count(std::uint64_t n) const;
+    // The k-th prime, k starts from 1: Nth(1) == 2.
+    std::uint64_t Nth(std::uint64_t k) const;
+
+    // Primes in increasing order.
+    const_iterator begin() const;
+    const_iterator end() const;
+    // First prime not less than n.
+    const_iterator lower_bound(std::uint64_t n) const;
+
+ private:
+    // Owns the memory behind bits and ranks: vectors or a file mapping.
+    struct Storage;
+
+    TPrime_Bitset();
+
+    // Smallest prime greater than n, or the end marker 0.
+    std::uint64_t Next(std::uint64_t n) const;
+
+    std::uint64_t limit;
+    std::shared_ptr<const Storage> storage;
+    const std::uint8_t* bits;
+    std::size_t bytes;
+    const std::uint64_t* ranks;
+    std::size_t rank_count;
+};
+
+#endif  // MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_BITSET_H_
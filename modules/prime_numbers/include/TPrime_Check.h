@@ -0,0 +1,19 @@
+// Copyright 2020 Kuzhelev Anton
+
+#ifndef MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_CHECK_H_
+#define MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_CHECK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Deterministic Miller-Rabin test, exact for every 64-bit number: small
+// factors are divided out first, then seven fixed witnesses are checked
+// with Montgomery multiplication.
+bool IsPrime(std::uint64_t n);
+
+// Checks count candidates: result[i] = IsPrime(candidates[i]).
+// Returns the number of primes among them.
+std::size_t IsPrime(const std::uint64_t* candidates, std::size_t count,
+                    bool* result);
+
+#endif  // MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_CHECK_H_
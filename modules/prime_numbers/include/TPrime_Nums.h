@@ -3,17 +3,91 @@
 #ifndef MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_NUMS_H_
 #define MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_NUMS_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <utility>
 
 class TPrime_Nums {
  public:
-    TPrime_Nums(int left, int right);
+    explicit TPrime_Nums(int left = 0, int right = 0);
     std::pair<int, int> GetInterval();
     std::vector<unsigned int> Get_Prime_Nums();
     void SetInterval(std::pair<int, int> interval);
+
+    // Same primes, found by threads_count workers (0 - all cores).
+    std::vector<unsigned int> Get_Prime_Nums(unsigned int threads_count);
+    // Number of primes in the interval, without materializing them.
+    std::uint64_t Count_Prime_Nums(unsigned int threads_count = 1);
+
+    // 64-bit intervals are split into independent chunks which a pool of
+    // threads_count workers (0 - all cores) sieves; results keep their order.
+    // Narrow intervals far from zero are checked by IsPrime instead.
+    static std::vector<std::uint64_t> Get_Prime_Nums(
+        std::uint64_t left, std::uint64_t right, unsigned int threads_count);
+    // Intervals much wider than right^(2/3) are counted as
+    // Prime_Pi(right) - Prime_Pi(left - 1).
+    static std::uint64_t Count_Prime_Nums(
+        std::uint64_t left, std::uint64_t right, unsigned int threads_count);
+    // Number of primes not greater than x by the Lagarias-Miller-Odlyzko
+    // algorithm in about O(x^(2/3)) time; both of its sieves are split
+    // between threads_count workers (0 - all cores).
+    static std::uint64_t Prime_Pi(std::uint64_t x,
+                                  unsigned int threads_count = 1);
+
  private:
     unsigned int left_edge, right_edge;
 };
 
+// Primes of [left, right] in increasing order, produced one sieve segment at
+// a time: memory is bounded by the segment and the base primes up to
+// sqrt(right), whatever the width of the interval. Narrow intervals far from
+// zero skip the base primes and check every odd number by IsPrime.
+class TPrime_Stream {
+ public:
+    TPrime_Stream(std::uint64_t left, std::uint64_t right);
+
+    // Stores the next prime and returns true, or returns false at the end.
+    bool Next(std::uint64_t* prime) {
+        if (pending_two) {
+            pending_two = false;
+            *prime = 2;
+            return true;
+        }
+        do {
+            while (position < flags.size()) {
+                std::size_t i = position++;
+                if (flags[i]) {
+                    *prime = segment_low + 2 * i;
+                    return true;
+                }
+            }
+        } while (Refill());
+        return false;
+    }
+
+ private:
+    // Sieves the next segment; false when the interval is exhausted.
+    bool Refill();
+
+    std::uint64_t right_edge;
+    std::uint64_t low;
+    std::uint64_t segment_low;
+    std::uint64_t segment_size;
+    std::size_t position;
+    bool pending_two;
+    bool narrow;
+    bool done;
+    std::vector<std::uint32_t> base_primes;
+    std::vector<char> flags;
+};
+
+// Calls callback(prime) for every prime of [left, right] in increasing order.
+template <typename Callback>
+void ForEachPrime(std::uint64_t left, std::uint64_t right, Callback callback) {
+    TPrime_Stream stream(left, right);
+    std::uint64_t prime;
+    while (stream.Next(&prime)) callback(prime);
+}
+
 #endif  // MODULES_PRIME_NUMBERS_INCLUDE_TPRIME_NUMS_H_
@@ -0,0 +1,298 @@
+// Copyright 2020 Kuzhelev Anton
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "include/TPrime_Bitset.h"
+#include "include/TPrime_Nums.h"
+
+namespace {
+
+const std::uint64_t kWheel = 30;
+const std::uint64_t kResidues[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+const std::uint64_t kSmallPrimes[3] = {2, 3, 5};
+// Bytes per rank counter.
+const std::size_t kRankBlock = 256;
+// Numbers enumerated at once while the set is built.
+const std::uint64_t kBuildWindow = 1 << 24;
+
+// Saved set: the header, the rank counters, then the bits, all in the
+// native byte order so that the file can be used in place.
+struct FileHeader {
+    char magic[8];
+    std::uint64_t limit;
+    std::uint64_t bytes;
+    std::uint64_t rank_count;
+};
+const char kMagic[8] = {'T', 'P', 'R', 'I', 'M', 'E', 'S', '1'};
+
+// Bit of the residue r (0..29), or -1 if r is not coprime to 30.
+int BitOf(std::uint64_t r) {
+    for (int bit = 0; bit < 8; ++bit)
+        if (kResidues[bit] == r) return bit;
+    return -1;
+}
+
+// Bits of a byte whose residues are not greater than r.
+std::uint8_t MaskUpTo(std::uint64_t r) {
+    std::uint8_t mask = 0;
+    for (int bit = 0; bit < 8; ++bit)
+        if (kResidues[bit] <= r) mask |= std::uint8_t(1) << bit;
+    return mask;
+}
+
+std::size_t PopCount(std::uint8_t byte) {
+    return std::bitset<8>(byte).count();
+}
+
+int LowestBit(std::uint8_t byte) {
+    int bit = 0;
+    while (!(byte & (1 << bit))) ++bit;
+    return bit;
+}
+
+std::uint64_t SmallPrimesUpTo(std::uint64_t n) {
+    return (n >= 2) + (n >= 3) + (n >= 5);
+}
+
+// Maps the whole file read-only; *size is 0 and *view nullptr if it is empty.
+void MapFile(const std::string& path, void** view, std::size_t* size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw -1;
+    }
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file, &file_size);
+    *size = static_cast<std::size_t>(file_size.QuadPart);
+    if (*size != 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+                                            nullptr);
+        *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+                        : nullptr;
+        if (mapping) CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (*size != 0 && *view == nullptr) {
+        throw -1;
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw -1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw -1;
+    }
+    *size = static_cast<std::size_t>(info.st_size);
+    if (*size != 0) {
+        void* mapped = mmap(nullptr, *size, PROT_READ, MAP_SHARED, fd, 0);
+        *view = mapped == MAP_FAILED ? nullptr : mapped;
+    }
+    close(fd);
+    if (*size != 0 && *view == nullptr) {
+        throw -1;
+    }
+#endif
+}
+
+}  // namespace
+
+struct TPrime_Bitset::Storage {
+    Storage() : view(nullptr), view_size(0) {}
+    ~Storage() {
+        if (view == nullptr) return;
+#ifdef _WIN32
+        UnmapViewOfFile(view);
+#else
+        munmap(view, view_size);
+#endif
+    }
+
+    std::vector<std::uint8_t> bits;
+    std::vector<std::uint64_t> ranks;
+    void* view;
+    std::size_t view_size;
+};
+
+TPrime_Bitset::TPrime_Bitset()
+    : limit(0), bits(nullptr), bytes(0), ranks(nullptr), rank_count(0) {}
+
+TPrime_Bitset::TPrime_Bitset(std::uint64_t limit_, unsigned int threads_count)
+    : limit(limit_) {
+    std::shared_ptr<Storage> built(new Storage());
+    std::vector<std::uint8_t>& wheel = built->bits;
+    std::vector<std::uint64_t>& index = built->ranks;
+    wheel.assign(static_cast<std::size_t>(limit / kWheel + 1), 0);
+    for (std::uint64_t low = 0;; low += kBuildWindow) {
+        std::uint64_t high = std::min(limit, low + kBuildWindow - 1);
+        std::vector<std::uint64_t> primes =
+            TPrime_Nums::Get_Prime_Nums(low, high, threads_count);
+        for (std::size_t i = 0; i < primes.size(); ++i) {
+            if (primes[i] < 7) continue;
+            wheel[static_cast<std::size_t>(primes[i] / kWheel)] |=
+                std::uint8_t(1) << BitOf(primes[i] % kWheel);
+        }
+        if (high == limit) break;
+    }
+
+    index.resize(wheel.size() / kRankBlock + 1);
+    std::uint64_t rank = 0;
+    for (std::size_t i = 0; i < wheel.size(); ++i) {
+        if (i % kRankBlock == 0) index[i / kRankBlock] = rank;
+        rank += PopCount(wheel[i]);
+    }
+    if (wheel.size() % kRankBlock == 0) index.back() = rank;
+
+    storage = built;
+    bits = wheel.data();
+    bytes = wheel.size();
+    ranks = index.data();
+    rank_count = index.size();
+}
+
+void TPrime_Bitset::Save(const std::string& path) const {
+    FileHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.limit = limit;
+    header.bytes = bytes;
+    header.rank_count = rank_count;
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+        throw -1;
+    }
+    bool written =
+        std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+        std::fwrite(ranks, sizeof(*ranks), rank_count, out) == rank_count &&
+        std::fwrite(bits, 1, bytes, out) == bytes;
+    if (std::fclose(out) != 0 || !written) {
+        throw -1;
+    }
+}
+
+TPrime_Bitset TPrime_Bitset::Open(const std::string& path) {
+    std::shared_ptr<Storage> mapped(new Storage());
+    MapFile(path, &mapped->view, &mapped->view_size);
+    FileHeader header;
+    if (mapped->view_size < sizeof(header)) {
+        throw -1;
+    }
+    std::memcpy(&header, mapped->view, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.bytes != header.limit / kWheel + 1 ||
+        header.rank_count != header.bytes / kRankBlock + 1 ||
+        mapped->view_size != sizeof(header) +
+            header.rank_count * sizeof(std::uint64_t) + header.bytes) {
+        throw -1;
+    }
+
+    TPrime_Bitset set;
+    set.limit = header.limit;
+    set.storage = mapped;
+    set.ranks = reinterpret_cast<const std::uint64_t*>(
+        static_cast<const char*>(mapped->view) + sizeof(header));
+    set.rank_count = static_cast<std::size_t>(header.rank_count);
+    set.bits = reinterpret_cast<const std::uint8_t*>(
+        set.ranks + set.rank_count);
+    set.bytes = static_cast<std::size_t>(header.bytes);
+    return set;
+}
+
+std::uint64_t TPrime_Bitset::Limit() const {
+    return limit;
+}
+
+std::size_t TPrime_Bitset::Bytes() const {
+    return bytes + rank_count * sizeof(*ranks);
+}
+
+bool TPrime_Bitset::Contains(std::uint64_t n) const {
+    if (n > limit) return false;
+    if (n < 7) return n == 2 || n == 3 || n == 5;
+    int bit = BitOf(n % kWheel);
+    return bit >= 0 && (bits[static_cast<std::size_t>(n / kWheel)] >> bit & 1);
+}
+
+std::uint64_t TPrime_Bitset::Count() const {
+    return Count(limit);
+}
+
+std::uint64_t TPrime_Bitset::Count(std::uint64_t n) const {
+    if (n > limit) {
+        throw -1;
+    }
+    std::size_t byte = static_cast<std::size_t>(n / kWheel);
+    std::uint64_t count = SmallPrimesUpTo(n) + ranks[byte / kRankBlock];
+    for (std::size_t i = byte / kRankBlock * kRankBlock; i < byte; ++i)
+        count += PopCount(bits[i]);
+    return count + PopCount(bits[byte] & MaskUpTo(n % kWheel));
+}
+
+std::uint64_t TPrime_Bitset::Nth(std::uint64_t k) const {
+    std::uint64_t small = SmallPrimesUpTo(limit);
+    if (k == 0 || k > Count()) {
+        throw -1;
+    }
+    if (k <= small) return kSmallPrimes[k - 1];
+    k -= small;
+
+    // Last rank block that starts with fewer than k primes before it.
+    std::size_t block = static_cast<std::size_t>(
+        std::lower_bound(ranks, ranks + rank_count, k) - ranks - 1);
+    std::uint64_t rank = ranks[block];
+    std::size_t byte = block * kRankBlock;
+    while (rank + PopCount(bits[byte]) < k) rank += PopCount(bits[byte++]);
+
+    std::uint8_t value = bits[byte];
+    for (; rank + 1 < k; ++rank) value &= value - 1;
+    return byte * kWheel + kResidues[LowestBit(value)];
+}
+
+std::uint64_t TPrime_Bitset::Next(std::uint64_t n) const {
+    std::uint64_t next = 0;
+    for (int i = 0; i < 3 && next == 0; ++i)
+        if (kSmallPrimes[i] > n) next = kSmallPrimes[i];
+    if (next == 0) {
+        std::size_t byte = static_cast<std::size_t>((n + 1) / kWheel);
+        std::uint8_t value = 0;
+        if (byte < bytes) {
+            std::uint64_t r = (n + 1) % kWheel;
+            value = bits[byte] & ~(r ? MaskUpTo(r - 1) : 0);
+        }
+        while (value == 0 && ++byte < bytes) value = bits[byte];
+        if (value == 0) return 0;
+        next = byte * kWheel + kResidues[LowestBit(value)];
+    }
+    return next <= limit ? next : 0;
+}
+
+TPrime_Bitset::const_iterator TPrime_Bitset::begin() const {
+    return const_iterator(this, Next(1));
+}
+
+TPrime_Bitset::const_iterator TPrime_Bitset::end() const {
+    return const_iterator(this, 0);
+}
+
+TPrime_Bitset::const_iterator TPrime_Bitset::lower_bound(
+    std::uint64_t n) const {
+    return const_iterator(this, n == 0 ? Next(0) : Next(n - 1));
+}
@@ -0,0 +1,119 @@
+// Copyright 2020 Kuzhelev Anton
+
+#include <cstdint>
+#include "include/TPrime_Check.h"
+
+namespace {
+
+const std::uint64_t kSmallPrimes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31,
+                                      37, 41, 43, 47, 53};
+// Smallest prime not in kSmallPrimes: below its square trial division is
+// already conclusive.
+const std::uint64_t kFirstUncheckedPrime = 59;
+// With these witnesses the test has no 64-bit pseudoprimes (J. Sinclair).
+const std::uint64_t kWitnesses[] = {2, 325, 9375, 28178, 450775, 9780504,
+                                    1795265022};
+
+// Full 128-bit product of a and b.
+void Multiply(std::uint64_t a, std::uint64_t b, std::uint64_t* high,
+              std::uint64_t* low) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    *high = static_cast<std::uint64_t>(product >> 64);
+    *low = static_cast<std::uint64_t>(product);
+#else
+    const std::uint64_t kMask = 0xFFFFFFFFu;
+    std::uint64_t lo_lo = (a & kMask) * (b & kMask);
+    std::uint64_t hi_lo = (a >> 32) * (b & kMask);
+    std::uint64_t lo_hi = (a & kMask) * (b >> 32);
+    std::uint64_t hi_hi = (a >> 32) * (b >> 32);
+    std::uint64_t cross = (lo_lo >> 32) + (hi_lo & kMask) + lo_hi;
+    *high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    *low = (cross << 32) | (lo_lo & kMask);
+#endif
+}
+
+// Arithmetic modulo an odd n on numbers kept in the Montgomery form
+// x * 2^64 mod n, so that no multiplication needs a 128-bit division.
+class Montgomery {
+ public:
+    explicit Montgomery(std::uint64_t n_) : n(n_), inverse(n_) {
+        // Newton's iteration doubles the correct low bits: 3, 6, ..., 96.
+        for (int i = 0; i < 5; ++i) inverse *= 2 - n * inverse;
+        one = (0 - n) % n;
+        square = one;
+        for (int i = 0; i < 64; ++i) square = Add(square, square);
+    }
+
+    std::uint64_t One() const { return one; }
+    std::uint64_t To(std::uint64_t x) const { return Multiply(x % n, square); }
+
+    std::uint64_t Multiply(std::uint64_t a, std::uint64_t b) const {
+        std::uint64_t high, low;
+        ::Multiply(a, b, &high, &low);
+        // Adding m * n clears the low half; only its high half is needed.
+        std::uint64_t m_high, m_low;
+        ::Multiply(low * inverse, n, &m_high, &m_low);
+        return high >= m_high ? high - m_high : high - m_high + n;
+    }
+
+    std::uint64_t Power(std::uint64_t base, std::uint64_t exponent) const {
+        std::uint64_t result = one;
+        for (; exponent != 0; exponent >>= 1) {
+            if (exponent & 1) result = Multiply(result, base);
+            base = Multiply(base, base);
+        }
+        return result;
+    }
+
+ private:
+    std::uint64_t Add(std::uint64_t a, std::uint64_t b) const {
+        std::uint64_t sum = a + b;
+        return sum < a || sum >= n ? sum - n : sum;
+    }
+
+    std::uint64_t n;
+    std::uint64_t inverse;  // n^-1 mod 2^64
+    std::uint64_t one;      // 2^64 mod n
+    std::uint64_t square;   // 2^128 mod n
+};
+
+}  // namespace
+
+bool IsPrime(std::uint64_t n) {
+    for (std::size_t i = 0; i < sizeof(kSmallPrimes) / sizeof(*kSmallPrimes);
+         ++i) {
+        if (n % kSmallPrimes[i] == 0) return n == kSmallPrimes[i];
+    }
+    if (n < kFirstUncheckedPrime * kFirstUncheckedPrime) return n > 1;
+
+    std::uint64_t odd = n - 1;
+    int twos = 0;
+    for (; odd % 2 == 0; odd /= 2) ++twos;
+
+    Montgomery field(n);
+    const std::uint64_t one = field.One();
+    const std::uint64_t minus_one = n - one;
+    for (std::size_t i = 0; i < sizeof(kWitnesses) / sizeof(*kWitnesses); ++i) {
+        if (kWitnesses[i] % n == 0) continue;
+        std::uint64_t x = field.Power(field.To(kWitnesses[i]), odd);
+        if (x == one || x == minus_one) continue;
+        bool composite = true;
+        for (int r = 1; r < twos && composite; ++r) {
+            x = field.Multiply(x, x);
+            composite = x != minus_one;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+std::size_t IsPrime(const std::uint64_t* candidates, std::size_t count,
+                    bool* result) {
+    std::size_t primes = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        result[i] = IsPrime(candidates[i]);
+        if (result[i]) ++primes;
+    }
+    return primes;
+}
@@ -1,10 +1,413 @@
 // Copyright 2020 Kuzhelev Anton
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
+#include "include/TPrime_Check.h"
 #include "include/TPrime_Nums.h"
 
-TPrime_Nums::TPrime_Nums(int left = 0, int right = 0) {
+namespace {
+
+// Odd numbers per segment: one byte each, 32 KiB fits into the L1 cache.
+const std::uint64_t kSegmentSize = 1 << 15;
+const std::uint64_t kMaxSegmentSize = 1 << 19;
+// Work split of the multithreaded enumeration.
+const std::uint64_t kSegmentsPerChunk = 4;
+const unsigned int kChunksPerThread = 8;
+// Intervals narrower than sqrt(right) / kNarrowRatio are cheaper to check
+// number by number than to sieve: the base primes alone cost sqrt(right).
+const std::uint64_t kNarrowRatio = 64;
+// Below kMinPiLmo pi(x) is simply sieved; intervals wider than
+// kWideRatio * right^(2/3) are counted as pi(right) - pi(left - 1).
+const std::uint64_t kMinPiLmo = 1 << 22;
+const std::uint64_t kWideRatio = 16;
+// Numbers per segment of the special leaves sieve.
+const std::uint64_t kLeafSegmentSize = 1 << 16;
+// Primes whose product is the period of the phi(n, c) table: 2 * ... * 13.
+const std::uint64_t kPhiTablePrimes = 6;
+
+std::uint64_t ISqrt(std::uint64_t n) {
+    const std::uint64_t kMaxRoot = 0xFFFFFFFFu;
+    std::uint64_t root = std::min(kMaxRoot, static_cast<std::uint64_t>(
+        std::sqrt(static_cast<double>(n))));
+    while (root * root > n) --root;
+    while (root < kMaxRoot && (root + 1) * (root + 1) <= n) ++root;
+    return root;
+}
+
+// Odd primes up to limit by the plain sieve of Eratosthenes.
+std::vector<std::uint32_t> OddBasePrimes(std::uint64_t limit) {
+    std::vector<std::uint32_t> primes;
+    std::vector<char> composite(limit / 2 + 1, 0);
+    for (std::uint64_t i = 3; i <= limit; i += 2) {
+        if (composite[i / 2]) continue;
+        primes.push_back(static_cast<std::uint32_t>(i));
+        for (std::uint64_t j = i * i; j <= limit; j += 2 * i)
+            composite[j / 2] = 1;
+    }
+    return primes;
+}
+
+// Marks the odd numbers low, low + 2, ..., up to high (low is odd, >= 3):
+// flags[i] != 0 iff low + 2 * i is prime. Base primes must cover sqrt(high).
+void SieveSegment(std::uint64_t low, std::uint64_t high,
+                  const std::vector<std::uint32_t>& base_primes,
+                  std::vector<char>* flags) {
+    std::size_t count = static_cast<std::size_t>((high - low) / 2 + 1);
+    flags->assign(count, 1);
+    for (std::size_t k = 0; k < base_primes.size(); ++k) {
+        std::uint64_t p = base_primes[k];
+        if (p * p > high) break;
+        // low + offset is the first odd multiple of p not below low; both
+        // low and p are odd, so the offset must be even.
+        std::uint64_t offset = (p - low % p) % p;
+        if (offset % 2 != 0) offset += p;
+        std::uint64_t first = p * p >= low ? (p * p - low) / 2 : offset / 2;
+        for (std::uint64_t i = first; i < count; i += p)
+            (*flags)[i] = 0;
+    }
+}
+
+// Same flags as SieveSegment, found by IsPrime without any base primes.
+void TestSegment(std::uint64_t low, std::uint64_t high,
+                 std::vector<char>* flags) {
+    std::size_t count = static_cast<std::size_t>((high - low) / 2 + 1);
+    flags->resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        (*flags)[i] = IsPrime(low + 2 * i);
+}
+
+bool IsNarrow(std::uint64_t left, std::uint64_t right) {
+    return right - left < ISqrt(right) / kNarrowRatio;
+}
+
+// Odd numbers per segment: the L1-sized block for small bounds, growing
+// towards an L2-sized one for large bounds so that the per-segment cost of
+// walking the base primes stays small compared to the sieving itself.
+std::uint64_t SegmentSize(std::uint64_t right) {
+    return std::min(kMaxSegmentSize, std::max(kSegmentSize, ISqrt(right) / 2));
+}
+
+// Last number of the segment starting at the odd low; never wraps around
+// near the top of the 64-bit range.
+std::uint64_t SegmentHigh(std::uint64_t low, std::uint64_t right,
+                          std::uint64_t segment_size) {
+    std::uint64_t span = 2 * (segment_size - 1);
+    return right - low <= span ? right : low + span;
+}
+
+// Calls visit(prime) for every prime of [left, right] in increasing order,
+// sieving one segment at a time. Base primes must cover sqrt(right); without
+// them (nullptr) every odd number is checked by IsPrime instead.
+template <typename Visitor>
+void SieveRange(std::uint64_t left, std::uint64_t right,
+                const std::vector<std::uint32_t>* base_primes,
+                Visitor visit) {
+    if (right < 2 || left > right) return;
+    if (left <= 2) visit(2);
+
+    std::uint64_t segment_size = SegmentSize(right);
+    std::vector<char> flags;
+    std::uint64_t low = std::max<std::uint64_t>(left, 3) | 1;
+    while (low <= right) {
+        std::uint64_t high = SegmentHigh(low, right, segment_size);
+        if (base_primes)
+            SieveSegment(low, high, *base_primes, &flags);
+        else
+            TestSegment(low, high, &flags);
+        for (std::size_t i = 0; i < flags.size(); ++i)
+            if (flags[i]) visit(low + 2 * i);
+        if (right - high < 2) break;
+        low = high + 2;
+    }
+}
+
+unsigned int ThreadsCount(unsigned int threads_count) {
+    if (threads_count == 0) threads_count = std::thread::hardware_concurrency();
+    return std::max(1u, threads_count);
+}
+
+// Splits [left, right] into independent chunks that a pool of threads_count
+// workers takes one by one; work(chunk, chunk_left, chunk_right) is called
+// once per chunk. Returns the number of chunks.
+template <typename Work>
+std::size_t ForEachChunk(std::uint64_t left, std::uint64_t right,
+                         unsigned int threads_count, Work work) {
+    // width - 1, so that [0, 2^64 - 1] does not wrap to zero; the chunk
+    // arithmetic below never goes past right either.
+    std::uint64_t span = right - left;
+    std::uint64_t min_width = 2 * SegmentSize(right) * kSegmentsPerChunk;
+    std::uint64_t chunks = std::min<std::uint64_t>(
+        threads_count * kChunksPerThread, span / min_width + 1);
+    if (chunks <= 1) {
+        work(0, left, right);
+        return 1;
+    }
+    std::uint64_t chunk_width = span / chunks + 1;
+    chunks = span / chunk_width + 1;
+
+    std::atomic<std::uint64_t> next(0);
+    auto worker = [&next, &work, chunks, chunk_width, left, right]() {
+        for (std::uint64_t chunk = next++; chunk < chunks; chunk = next++) {
+            std::uint64_t low = left + chunk * chunk_width;
+            std::uint64_t high =
+                right - low < chunk_width ? right : low + chunk_width - 1;
+            work(static_cast<std::size_t>(chunk), low, high);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threads_count; ++t)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::size_t t = 0; t < threads.size(); ++t) threads[t].join();
+    return static_cast<std::size_t>(chunks);
+}
+
+std::uint64_t SieveCount(std::uint64_t left, std::uint64_t right,
+                         unsigned int threads_count) {
+    const bool narrow = IsNarrow(left, right);
+    const std::vector<std::uint32_t> base_primes =
+        narrow ? std::vector<std::uint32_t>() : OddBasePrimes(ISqrt(right));
+    const std::vector<std::uint32_t>* base = narrow ? nullptr : &base_primes;
+    std::vector<std::uint64_t> chunk_counts(
+        ThreadsCount(threads_count) * kChunksPerThread, 0);
+    ForEachChunk(left, right, ThreadsCount(threads_count),
+        [base, &chunk_counts](std::size_t chunk, std::uint64_t low,
+                              std::uint64_t high) {
+            std::uint64_t count = 0;
+            SieveRange(low, high, base, [&count](std::uint64_t) {
+                ++count;
+            });
+            chunk_counts[chunk] = count;
+        });
+
+    std::uint64_t total = 0;
+    for (std::size_t chunk = 0; chunk < chunk_counts.size(); ++chunk)
+        total += chunk_counts[chunk];
+    return total;
+}
+
+std::uint64_t ICbrt(std::uint64_t n) {
+    const std::uint64_t kMaxRoot = 2642245;
+    std::uint64_t root = std::min(kMaxRoot, static_cast<std::uint64_t>(
+        std::cbrt(static_cast<double>(n))));
+    while (root * root * root > n) --root;
+    while (root < kMaxRoot && (root + 1) * (root + 1) * (root + 1) <= n)
+        ++root;
+    return root;
+}
+
+// phi(n, c): numbers of [1, n] without prime factors among the first c
+// primes. It is periodic modulo their product, so one period is tabulated.
+class PhiTable {
+ public:
+    PhiTable(const std::vector<std::uint64_t>& primes, std::uint64_t c)
+        : period(1) {
+        for (std::uint64_t k = 1; k <= c; ++k) period *= primes[k];
+        std::vector<char> coprime(period, 1);
+        for (std::uint64_t k = 1; k <= c; ++k)
+            for (std::uint64_t j = 0; j < period; j += primes[k])
+                coprime[j] = 0;
+        counts.assign(period + 1, 0);
+        for (std::uint64_t r = 1; r <= period; ++r)
+            counts[r] = counts[r - 1] + coprime[r % period];
+    }
+
+    std::uint64_t Phi(std::uint64_t n) const {
+        return n / period * counts[period] + counts[n % period];
+    }
+
+ private:
+    std::uint64_t period;
+    std::vector<std::uint64_t> counts;
+};
+
+// Binary indexed tree over the numbers of a segment that are still unsieved.
+class UnsievedCounter {
+ public:
+    explicit UnsievedCounter(const std::vector<char>& flags)
+        : tree(flags.size() + 1, 0) {
+        for (std::size_t i = 1; i < tree.size(); ++i) {
+            tree[i] += flags[i - 1];
+            std::size_t parent = i + (i & (0 - i));
+            if (parent < tree.size()) tree[parent] += tree[i];
+        }
+    }
+
+    // Unsieved numbers among the first index + 1 of the segment.
+    std::uint64_t Count(std::uint64_t index) const {
+        std::uint64_t count = 0;
+        for (std::size_t i = index + 1; i > 0; i -= i & (0 - i))
+            count += tree[i];
+        return count;
+    }
+
+    void Remove(std::uint64_t index) {
+        for (std::size_t i = index + 1; i < tree.size(); i += i & (0 - i))
+            --tree[i];
+    }
+
+ private:
+    std::vector<std::uint32_t> tree;
+};
+
+// Tables of the Lagarias-Miller-Odlyzko algorithm for x with y >= x^(1/3):
+// primes[k] is the k-th prime (primes[0] is unused), lpf[n] the least prime
+// factor of n <= y and mu[n] its Moebius function.
+struct LmoTables {
+    std::uint64_t x, y, a, c;
+    std::vector<std::uint64_t> primes;
+    std::vector<std::uint64_t> lpf;
+    std::vector<int> mu;
+};
+
+// Contribution of the special leaves p_b * m (m <= y < p_b * m) whose values
+// x / (p_b * m) fall into [chunk_low, chunk_high]. The number phi(v, b - 1)
+// of such a leaf is split into the unknown count below chunk_low, which is
+// added later as phi[b] of the preceding chunks times mu_sum[b], and the
+// count inside the chunk, which is already in s2.
+struct LeafChunk {
+    std::int64_t s2;
+    std::vector<std::uint64_t> phi;
+    std::vector<std::int64_t> mu_sum;
+};
+
+void SpecialLeaves(const LmoTables& t, std::uint64_t chunk_low,
+                   std::uint64_t chunk_high, LeafChunk* out) {
+    out->s2 = 0;
+    out->phi.assign(t.a + 1, 0);
+    out->mu_sum.assign(t.a + 1, 0);
+    std::vector<std::uint64_t> next(t.a + 1);
+    for (std::uint64_t b = 1; b <= t.a; ++b)
+        next[b] = (chunk_low + t.primes[b] - 1) / t.primes[b] * t.primes[b];
+
+    std::vector<char> flags;
+    for (std::uint64_t low = chunk_low; low <= chunk_high;
+         low += kLeafSegmentSize) {
+        std::uint64_t high = std::min(chunk_high, low + kLeafSegmentSize - 1);
+        flags.assign(high - low + 1, 1);
+        for (std::uint64_t b = 1; b <= t.c; ++b) {
+            for (; next[b] <= high; next[b] += t.primes[b])
+                flags[next[b] - low] = 0;
+        }
+        UnsievedCounter counter(flags);
+        std::uint64_t unsieved = counter.Count(high - low);
+
+        for (std::uint64_t b = t.c + 1; b < t.a; ++b) {
+            std::uint64_t p = t.primes[b];
+            std::uint64_t min_m = std::max(t.x / (p * (high + 1)), t.y / p);
+            std::uint64_t max_m = std::min(t.x / (p * low), t.y);
+            // Larger primes have no leaves here nor in further segments.
+            if (p >= max_m) break;
+            for (std::uint64_t m = max_m; m > min_m; --m) {
+                if (t.mu[m] == 0 || t.lpf[m] <= p) continue;
+                std::uint64_t value = t.x / (p * m);
+                out->s2 -= t.mu[m] * static_cast<std::int64_t>(
+                    out->phi[b] + counter.Count(value - low));
+                out->mu_sum[b] += t.mu[m];
+            }
+            out->phi[b] += unsieved;
+            for (; next[b] <= high; next[b] += p) {
+                if (!flags[next[b] - low]) continue;
+                flags[next[b] - low] = 0;
+                counter.Remove(next[b] - low);
+                --unsieved;
+            }
+        }
+    }
+}
+
+// Sum of pi(x / p) - pi(p) + 1 over the primes p of (y, sqrt(x)]: the
+// numbers up to x with two prime factors above y.
+std::uint64_t P2(const LmoTables& t, const std::vector<std::uint64_t>& roots,
+                 unsigned int threads_count) {
+    // roots holds the primes up to sqrt(x); the values x / p lie in
+    // [sqrt(x), x / y] and grow as p decreases.
+    std::size_t first = static_cast<std::size_t>(t.a);
+    std::size_t last = roots.size();
+    if (first >= last) return 0;
+    std::uint64_t low = ISqrt(t.x);
+    std::uint64_t high = t.x / t.y;
+    std::uint64_t pi_below_low = static_cast<std::uint64_t>(
+        std::lower_bound(roots.begin(), roots.end(), low) - roots.begin());
+
+    const std::vector<std::uint32_t> base_primes = OddBasePrimes(ISqrt(high));
+    std::vector<std::uint64_t> chunk_counts(
+        ThreadsCount(threads_count) * kChunksPerThread, 0);
+    std::vector<std::uint64_t> chunk_sums(chunk_counts.size(), 0);
+    std::vector<std::uint64_t> chunk_queries(chunk_counts.size(), 0);
+    const std::uint64_t x = t.x;
+    std::size_t chunks = ForEachChunk(low, high, ThreadsCount(threads_count),
+        [&roots, &base_primes, &chunk_counts, &chunk_sums, &chunk_queries,
+         first, x](std::size_t chunk, std::uint64_t chunk_low,
+                   std::uint64_t chunk_high) {
+            // Queries are the primes roots[query_end..query) with x / p in
+            // the chunk, answered from the largest p down.
+            std::size_t query = static_cast<std::size_t>(
+                std::upper_bound(roots.begin() + first, roots.end(),
+                                 x / chunk_low) - roots.begin());
+            std::size_t query_end = static_cast<std::size_t>(
+                std::upper_bound(roots.begin() + first, roots.end(),
+                                 x / (chunk_high + 1)) - roots.begin());
+            chunk_queries[chunk] = query - query_end;
+            std::uint64_t count = 0, sum = 0;
+            SieveRange(chunk_low, chunk_high, &base_primes,
+                       [&roots, &query, &count, &sum, query_end, x](
+                           std::uint64_t prime) {
+                while (query > query_end && x / roots[query - 1] < prime) {
+                    sum += count;
+                    --query;
+                }
+                ++count;
+            });
+            sum += count * (query - query_end);
+            chunk_counts[chunk] = count;
+            chunk_sums[chunk] = sum;
+        });
+
+    std::uint64_t result = 0, primes_before = pi_below_low;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        result += chunk_sums[chunk] + chunk_queries[chunk] * primes_before;
+        primes_before += chunk_counts[chunk];
+    }
+    // pi(p_k) - 1 = k - 1 for k = first + 1, ..., last.
+    for (std::size_t k = first + 1; k <= last; ++k) result -= k - 1;
+    return result;
+}
+
+}  // namespace
+
+TPrime_Stream::TPrime_Stream(std::uint64_t left, std::uint64_t right)
+    : right_edge(right), low(std::max<std::uint64_t>(left, 3) | 1),
+      segment_low(0), segment_size(0), position(0),
+      pending_two(left <= 2 && right >= 2),
+      narrow(IsNarrow(left, right)), done(left > right || low > right) {
+    if (done) return;
+    if (!narrow) base_primes = OddBasePrimes(ISqrt(right));
+    segment_size = SegmentSize(right);
+}
+
+bool TPrime_Stream::Refill() {
+    if (done) return false;
+    std::uint64_t high = SegmentHigh(low, right_edge, segment_size);
+    if (narrow)
+        TestSegment(low, high, &flags);
+    else
+        SieveSegment(low, high, base_primes, &flags);
+    segment_low = low;
+    position = 0;
+    if (right_edge - high < 2)
+        done = true;
+    else
+        low = high + 2;
+    return true;
+}
+
+TPrime_Nums::TPrime_Nums(int left, int right) {
     if (left < 0 || right < 0 || left > right) {
         throw -1;
     }
@@ -27,17 +430,126 @@ std::pair<int, int> TPrime_Nums::GetInterval() {
 
 std::vector<unsigned int> TPrime_Nums::Get_Prime_Nums() {
     std::vector<unsigned int> result;
+    ForEachPrime(left_edge, right_edge, [&result](std::uint64_t prime) {
+        result.push_back(static_cast<unsigned int>(prime));
+    });
+    return result;
+}
 
-    for (unsigned int i = left_edge; i <= right_edge; ++i) {
-        unsigned int j;
-        for (j = 2; j < i; ++j) {
-            if (i % j == 0) {
-                break;
-            }
+std::vector<unsigned int> TPrime_Nums::Get_Prime_Nums(
+    unsigned int threads_count) {
+    std::vector<std::uint64_t> primes =
+        Get_Prime_Nums(left_edge, right_edge, threads_count);
+    return std::vector<unsigned int>(primes.begin(), primes.end());
+}
+
+std::uint64_t TPrime_Nums::Count_Prime_Nums(unsigned int threads_count) {
+    return Count_Prime_Nums(left_edge, right_edge, threads_count);
+}
+
+std::vector<std::uint64_t> TPrime_Nums::Get_Prime_Nums(
+    std::uint64_t left, std::uint64_t right, unsigned int threads_count) {
+    if (left > right) {
+        throw -1;
+    }
+    const bool narrow = IsNarrow(left, right);
+    const std::vector<std::uint32_t> base_primes =
+        narrow ? std::vector<std::uint32_t>() : OddBasePrimes(ISqrt(right));
+    const std::vector<std::uint32_t>* base = narrow ? nullptr : &base_primes;
+    std::vector<std::vector<std::uint64_t> > chunk_primes(
+        ThreadsCount(threads_count) * kChunksPerThread);
+    std::size_t chunks = ForEachChunk(left, right, ThreadsCount(threads_count),
+        [base, &chunk_primes](std::size_t chunk, std::uint64_t low,
+                              std::uint64_t high) {
+            std::vector<std::uint64_t>* primes = &chunk_primes[chunk];
+            SieveRange(low, high, base, [primes](std::uint64_t prime) {
+                primes->push_back(prime);
+            });
+        });
+
+    std::size_t total = 0;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        total += chunk_primes[chunk].size();
+    std::vector<std::uint64_t> result;
+    result.reserve(total);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        result.insert(result.end(), chunk_primes[chunk].begin(),
+                      chunk_primes[chunk].end());
+        std::vector<std::uint64_t>().swap(chunk_primes[chunk]);
+    }
+    return result;
+}
+
+std::uint64_t TPrime_Nums::Count_Prime_Nums(
+    std::uint64_t left, std::uint64_t right, unsigned int threads_count) {
+    if (left > right) {
+        throw -1;
+    }
+    std::uint64_t root = ICbrt(right);
+    if (right >= kMinPiLmo && (right - left) / kWideRatio > root * root) {
+        return Prime_Pi(right, threads_count) -
+            (left == 0 ? 0 : Prime_Pi(left - 1, threads_count));
+    }
+    return SieveCount(left, right, threads_count);
+}
+
+std::uint64_t TPrime_Nums::Prime_Pi(std::uint64_t x,
+                                    unsigned int threads_count) {
+    if (x < kMinPiLmo) return SieveCount(0, x, threads_count);
+
+    // y = alpha * x^(1/3) trades the special leaves (about y^2 / log y)
+    // against the sieving up to x / y.
+    LmoTables t;
+    t.x = x;
+    double alpha = std::max(1.0, std::log(static_cast<double>(x)) / 12);
+    t.y = static_cast<std::uint64_t>(alpha * ICbrt(x));
+    std::vector<std::uint64_t> roots = Get_Prime_Nums(0, ISqrt(x), 1);
+    t.a = static_cast<std::uint64_t>(
+        std::upper_bound(roots.begin(), roots.end(), t.y) - roots.begin());
+    t.c = std::min(t.a, kPhiTablePrimes);
+    t.primes.assign(1, 0);
+    t.primes.insert(t.primes.end(), roots.begin(), roots.begin() + t.a);
+
+    t.lpf.assign(t.y + 1, 0);
+    t.mu.assign(t.y + 1, 1);
+    t.lpf[1] = t.y + 1;
+    for (std::uint64_t k = 1; k <= t.a; ++k) {
+        std::uint64_t p = t.primes[k];
+        for (std::uint64_t n = p; n <= t.y; n += p) {
+            if (t.lpf[n] == 0) t.lpf[n] = p;
+            t.mu[n] = -t.mu[n];
         }
-        if (j == i) {
-            result.push_back(i);
+        for (std::uint64_t n = p * p; n <= t.y; n += p * p) t.mu[n] = 0;
+    }
+
+    // Ordinary leaves: mu(n) * phi(x / n, c) for n <= y free of the first
+    // c primes.
+    PhiTable phi_table(t.primes, t.c);
+    std::int64_t s1 = 0;
+    for (std::uint64_t n = 1; n <= t.y; ++n) {
+        if (t.mu[n] == 0 || t.lpf[n] <= t.primes[t.c]) continue;
+        s1 += t.mu[n] * static_cast<std::int64_t>(phi_table.Phi(x / n));
+    }
+
+    // Special leaves, sieved chunk by chunk over [1, x / y].
+    std::vector<LeafChunk> leaves(ThreadsCount(threads_count) *
+                                  kChunksPerThread);
+    std::size_t chunks = ForEachChunk(1, x / t.y, ThreadsCount(threads_count),
+        [&t, &leaves](std::size_t chunk, std::uint64_t low,
+                      std::uint64_t high) {
+            SpecialLeaves(t, low, high, &leaves[chunk]);
+        });
+    std::int64_t s2 = 0;
+    std::vector<std::uint64_t> phi(t.a + 1, 0);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        s2 += leaves[chunk].s2;
+        for (std::uint64_t b = 1; b <= t.a; ++b) {
+            s2 -= leaves[chunk].mu_sum[b] * static_cast<std::int64_t>(phi[b]);
+            phi[b] += leaves[chunk].phi[b];
         }
     }
-    return result;
+
+    std::int64_t phi_x_a = s1 + s2;
+    return static_cast<std::uint64_t>(phi_x_a) + t.a - 1 -
+        P2(t, roots, threads_count);
 }
@@ -0,0 +1,135 @@
+// Copyright 2020 Kuzhelev Anton
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "include/TPrime_Bitset.h"
+#include "include/TPrime_Nums.h"
+
+TEST(TPrime_Bitset, contains_exactly_the_sieved_primes) {
+    // Arrange
+    TPrime_Bitset set(100000);
+    TPrime_Nums p(0, 100000);
+    std::vector<unsigned int> primes = p.Get_Prime_Nums();
+    std::vector<bool> expected(100001, false);
+    for (size_t i = 0; i < primes.size(); ++i) {
+        expected[primes[i]] = true;
+    }
+    // Act & Assert
+    for (unsigned int n = 0; n <= 100000; ++n) {
+        ASSERT_EQ(expected[n], set.Contains(n)) << n;
+    }
+    EXPECT_FALSE(set.Contains(100003));
+}
+
+TEST(TPrime_Bitset, can_count_primes) {
+    // Arrange
+    TPrime_Bitset set(1000000);
+    // Act & Assert
+    EXPECT_EQ(78498u, set.Count());
+    EXPECT_EQ(0u, set.Count(1));
+    EXPECT_EQ(3u, set.Count(6));
+    EXPECT_EQ(4u, set.Count(7));
+    EXPECT_EQ(25u, set.Count(100));
+    EXPECT_EQ(9592u, set.Count(100000));
+}
+
+TEST(TPrime_Bitset, can_find_nth_prime) {
+    // Arrange
+    TPrime_Bitset set(1000000, 2);
+    // Act & Assert
+    EXPECT_EQ(2u, set.Nth(1));
+    EXPECT_EQ(5u, set.Nth(3));
+    EXPECT_EQ(7u, set.Nth(4));
+    EXPECT_EQ(104729u, set.Nth(10000));
+    EXPECT_EQ(999983u, set.Nth(78498));
+}
+
+TEST(TPrime_Bitset, cannot_find_nth_prime_out_of_set) {
+    // Arrange
+    TPrime_Bitset set(100);
+    // Act & Assert
+    ASSERT_ANY_THROW(set.Nth(0));
+    ASSERT_ANY_THROW(set.Nth(26));
+}
+
+TEST(TPrime_Bitset, iterates_primes_in_order) {
+    // Arrange
+    TPrime_Bitset set(50000);
+    TPrime_Nums p(0, 50000);
+    std::vector<unsigned int> expected = p.Get_Prime_Nums();
+    // Act
+    std::vector<unsigned int> primes(set.begin(), set.end());
+    // Assert
+    EXPECT_EQ(expected, primes);
+}
+
+TEST(TPrime_Bitset, handles_tiny_limits) {
+    // Arrange
+    TPrime_Bitset empty(1);
+    TPrime_Bitset two(2);
+    TPrime_Bitset five(6);
+    // Act & Assert
+    EXPECT_EQ(0u, empty.Count());
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_EQ(1u, two.Count());
+    EXPECT_EQ(3u, five.Count());
+    EXPECT_EQ(std::vector<unsigned int>({2, 3, 5}),
+              std::vector<unsigned int>(five.begin(), five.end()));
+}
+
+TEST(TPrime_Bitset, takes_one_byte_per_thirty_numbers) {
+    // Arrange
+    TPrime_Bitset set(3000000);
+    // Act & Assert
+    EXPECT_LT(set.Bytes(), 3000000u / 30 * 21 / 20);
+}
+
+TEST(TPrime_Bitset, can_start_iteration_from_any_number) {
+    // Arrange
+    TPrime_Bitset set(1000);
+    // Act & Assert
+    EXPECT_EQ(2u, *set.lower_bound(0));
+    EXPECT_EQ(2u, *set.lower_bound(2));
+    EXPECT_EQ(5u, *set.lower_bound(4));
+    EXPECT_EQ(97u, *set.lower_bound(90));
+    EXPECT_EQ(997u, *set.lower_bound(997));
+    EXPECT_TRUE(set.lower_bound(998) == set.end());
+}
+
+TEST(TPrime_Bitset, can_save_and_open_mapped_set) {
+    // Arrange
+    const std::string path = "test_prime_bitset_saved.bin";
+    TPrime_Bitset built(2000000, 2);
+    built.Save(path);
+    // Act
+    TPrime_Bitset opened = TPrime_Bitset::Open(path);
+    TPrime_Bitset copy = opened;
+    // Assert
+    EXPECT_EQ(2000000u, opened.Limit());
+    EXPECT_EQ(built.Bytes(), opened.Bytes());
+    EXPECT_EQ(148933u, opened.Count());
+    EXPECT_EQ(1299709u, opened.Nth(100000));
+    EXPECT_TRUE(opened.Contains(1999993));
+    EXPECT_FALSE(opened.Contains(1999995));
+    EXPECT_EQ(std::vector<std::uint64_t>(built.lower_bound(1000000),
+                                         built.end()),
+              std::vector<std::uint64_t>(copy.lower_bound(1000000),
+                                         copy.end()));
+    std::remove(path.c_str());
+}
+
+TEST(TPrime_Bitset, cannot_open_missing_or_foreign_file) {
+    // Arrange
+    const std::string path = "test_prime_bitset_foreign.bin";
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("not a prime table, just some text of a sufficient size", file);
+    std::fclose(file);
+    // Act & Assert
+    ASSERT_ANY_THROW(TPrime_Bitset::Open("test_prime_bitset_missing.bin"));
+    ASSERT_ANY_THROW(TPrime_Bitset::Open(path));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,109 @@
+// Copyright 2020 Kuzhelev Anton
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+#include "include/TPrime_Check.h"
+#include "include/TPrime_Nums.h"
+
+TEST(IsPrime, matches_sieve_up_to_million) {
+    // Arrange
+    TPrime_Nums p(0, 1000000);
+    std::vector<unsigned int> primes = p.Get_Prime_Nums();
+    std::vector<bool> expected(1000001, false);
+    for (size_t i = 0; i < primes.size(); ++i) {
+        expected[primes[i]] = true;
+    }
+    // Act & Assert
+    for (std::uint64_t n = 0; n <= 1000000; ++n) {
+        ASSERT_EQ(expected[n], IsPrime(n)) << n;
+    }
+}
+
+TEST(IsPrime, rejects_strong_pseudoprimes) {
+    // Act & Assert
+    EXPECT_FALSE(IsPrime(561u));
+    EXPECT_FALSE(IsPrime(2047u));
+    EXPECT_FALSE(IsPrime(3215031751ULL));
+    EXPECT_FALSE(IsPrime(3825123056546413051ULL));
+    EXPECT_FALSE(IsPrime(18446744030759878681ULL));  // 4294967291^2
+}
+
+TEST(IsPrime, handles_numbers_near_2_to_64) {
+    // Act & Assert
+    EXPECT_TRUE(IsPrime(4294967291ULL));
+    EXPECT_TRUE(IsPrime(4294967311ULL));
+    EXPECT_TRUE(IsPrime(1000000000000000003ULL));
+    EXPECT_TRUE(IsPrime(18446744073709551557ULL));
+    EXPECT_FALSE(IsPrime(18446744073709551615ULL));
+    EXPECT_FALSE(IsPrime(18446744073709551559ULL));
+}
+
+TEST(IsPrime, can_check_batch) {
+    // Arrange
+    const std::uint64_t candidates[] = {0, 1, 2, 9, 97, 1000000007,
+                                        18446744073709551557ULL};
+    bool result[7];
+    // Act
+    std::size_t primes = IsPrime(candidates, 7, result);
+    // Assert
+    EXPECT_EQ(4u, primes);
+    EXPECT_FALSE(result[0]);
+    EXPECT_FALSE(result[1]);
+    EXPECT_TRUE(result[2]);
+    EXPECT_FALSE(result[3]);
+    EXPECT_TRUE(result[4]);
+    EXPECT_TRUE(result[5]);
+    EXPECT_TRUE(result[6]);
+}
+
+TEST(IsPrime, narrow_interval_far_from_zero_is_not_sieved) {
+    // Arrange
+    const std::uint64_t left = 1000000000000000000ULL;
+    // Act
+    std::vector<std::uint64_t> res =
+        TPrime_Nums::Get_Prime_Nums(left, left + 1000, 2);
+    // Assert
+    EXPECT_EQ(23u, res.size());
+    EXPECT_EQ(1000000000000000003ULL, res[0]);
+    EXPECT_EQ(1000000000000000009ULL, res[1]);
+}
+
+TEST(IsPrime, can_stream_primes_at_top_of_64_bit_range) {
+    // Arrange
+    const std::uint64_t right = 18446744073709551615ULL;
+    std::uint64_t count = 0, first = 0, last = 0;
+    // Act
+    ForEachPrime(right - 999, right,
+                 [&count, &first, &last](std::uint64_t prime) {
+        if (count++ == 0) first = prime;
+        last = prime;
+    });
+    // Assert
+    EXPECT_EQ(21u, count);
+    EXPECT_EQ(21u, TPrime_Nums::Count_Prime_Nums(right - 999, right, 1));
+    EXPECT_EQ(18446744073709550671ULL, first);
+    EXPECT_EQ(18446744073709551557ULL, last);
+}
+
+TEST(IsPrime, can_split_interval_ending_at_top_of_64_bit_range) {
+    // Arrange: one more number than two minimal chunks, so that the last
+    // chunk is shorter than the others and ends at 2^64 - 1.
+    const std::uint64_t right = 18446744073709551615ULL;
+    const std::uint64_t left = right - 4194304;
+    std::uint64_t expect = 0, last = 0;
+    ForEachPrime(left, right, [&expect, &last](std::uint64_t prime) {
+        ++expect;
+        last = prime;
+    });
+    // Act
+    std::vector<std::uint64_t> primes =
+        TPrime_Nums::Get_Prime_Nums(left, right, 4);
+    // Assert
+    EXPECT_EQ(expect, TPrime_Nums::Count_Prime_Nums(left, right, 1));
+    EXPECT_EQ(expect, TPrime_Nums::Count_Prime_Nums(left, right, 3));
+    ASSERT_EQ(expect, primes.size());
+    EXPECT_EQ(last, primes.back());
+    EXPECT_EQ(18446744073709551557ULL, last);
+}
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <climits>
 #include <utility>
 #include <vector>
 #include "include/TPrime_Nums.h"
@@ -19,9 +21,27 @@ bool compare_vec(std::vector<unsigned int> v1, std::vector<unsigned int> v2) {
     return true;
 }
 
+std::vector<unsigned int> trial_division(unsigned int left,
+                                         unsigned int right) {
+    std::vector<unsigned int> result;
+    for (unsigned int i = std::max(left, 2u); i <= right; ++i) {
+        bool prime = true;
+        for (unsigned int j = 2; j * j <= i; ++j) {
+            if (i % j == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
 TEST(TPrime_Nums, can_create_default_class) {
     // Arrange, Act and Assert
-    ASSERT_NO_THROW(TPrime_Nums p());
+    ASSERT_NO_THROW(TPrime_Nums p);
 }
 
 TEST(TPrime_Nums, can_create_class_with_valid_parameters) {
@@ -101,7 +121,7 @@ TEST(TPrime_Nums, check_that_no_primes_on_0_to_1) {
     // Act
     std::vector<unsigned int> primes = p.Get_Prime_Nums();
     // Assert
-    EXPECT_EQ(0, primes.size());
+    EXPECT_EQ(0u, primes.size());
 }
 
 TEST(TPrime_Nums, check_interval_7_7) {
@@ -110,7 +130,7 @@ TEST(TPrime_Nums, check_interval_7_7) {
     // Act
     std::vector<unsigned int> result = p.Get_Prime_Nums();
     // Assert
-    EXPECT_EQ(7, result[0]);
+    EXPECT_EQ(7u, result[0]);
 }
 
 TEST(TPrime_Nums, check_prime_nums_from_0_to_10) {
@@ -129,5 +149,146 @@ TEST(TPrime_Nums, check_no_prime_nums_between_212_to_222) {
     // Act
     std::vector<unsigned int> res = p.Get_Prime_Nums();
     // Assert
-    EXPECT_EQ(0, res.size());
+    EXPECT_EQ(0u, res.size());
+}
+
+TEST(TPrime_Nums, check_sieve_matches_trial_division_from_0_to_10000) {
+    // Arrange
+    TPrime_Nums p(0, 10000);
+    // Act
+    std::vector<unsigned int> res = p.Get_Prime_Nums();
+    // Assert
+    EXPECT_TRUE(compare_vec(res, trial_division(0, 10000)));
+}
+
+TEST(TPrime_Nums, check_sieve_across_segment_borders) {
+    // Arrange
+    TPrime_Nums p(65000, 400001);
+    // Act
+    std::vector<unsigned int> res = p.Get_Prime_Nums();
+    // Assert
+    EXPECT_TRUE(compare_vec(res, trial_division(65000, 400001)));
+}
+
+TEST(TPrime_Nums, check_count_of_primes_up_to_million) {
+    // Arrange
+    TPrime_Nums p(0, 1000000);
+    // Act
+    std::vector<unsigned int> res = p.Get_Prime_Nums();
+    // Assert
+    EXPECT_EQ(78498u, res.size());
+}
+
+TEST(TPrime_Nums, check_primes_near_int_max) {
+    // Arrange
+    TPrime_Nums p(INT_MAX - 100, INT_MAX);
+    // Act
+    std::vector<unsigned int> res = p.Get_Prime_Nums();
+    // Assert
+    EXPECT_TRUE(compare_vec(res, trial_division(INT_MAX - 100, INT_MAX)));
+    EXPECT_EQ(static_cast<unsigned int>(INT_MAX), res.back());
+}
+
+TEST(TPrime_Nums, check_parallel_primes_match_sequential_ones) {
+    // Arrange
+    TPrime_Nums p(1000, 3000000);
+    // Act
+    std::vector<unsigned int> sequential = p.Get_Prime_Nums();
+    std::vector<unsigned int> parallel = p.Get_Prime_Nums(4);
+    // Assert
+    EXPECT_TRUE(compare_vec(sequential, parallel));
+}
+
+TEST(TPrime_Nums, check_count_of_primes_up_to_ten_million) {
+    // Arrange
+    TPrime_Nums p(0, 10000000);
+    // Act & Assert
+    EXPECT_EQ(664579u, p.Count_Prime_Nums(0));
+}
+
+TEST(TPrime_Nums, check_primes_near_10_to_12) {
+    // Arrange
+    const std::uint64_t left = 1000000000000ULL;
+    // Act
+    std::vector<std::uint64_t> res =
+        TPrime_Nums::Get_Prime_Nums(left, left + 1000000, 4);
+    std::uint64_t count =
+        TPrime_Nums::Count_Prime_Nums(left, left + 1000000, 3);
+    // Assert
+    EXPECT_EQ(36249u, res.size());
+    EXPECT_EQ(36249u, count);
+    EXPECT_EQ(1000000000039ULL, res.front());
+    EXPECT_TRUE(std::is_sorted(res.begin(), res.end()));
+}
+
+TEST(TPrime_Nums, check_that_cannot_count_reversed_interval) {
+    // Act & Assert
+    ASSERT_ANY_THROW(TPrime_Nums::Count_Prime_Nums(10, 5, 1));
+}
+
+TEST(TPrime_Stream, check_stream_matches_sieve_across_segments) {
+    // Arrange
+    TPrime_Nums p(0, 3000000);
+    std::vector<unsigned int> expected = p.Get_Prime_Nums(1);
+    TPrime_Stream stream(0, 3000000);
+    std::vector<unsigned int> res;
+    std::uint64_t prime;
+    // Act
+    while (stream.Next(&prime))
+        res.push_back(static_cast<unsigned int>(prime));
+    // Assert
+    EXPECT_TRUE(compare_vec(expected, res));
+    EXPECT_FALSE(stream.Next(&prime));
+}
+
+TEST(TPrime_Stream, check_stream_of_interval_without_primes) {
+    // Arrange
+    TPrime_Stream stream(24, 28);
+    std::uint64_t prime;
+    // Act & Assert
+    EXPECT_FALSE(stream.Next(&prime));
+}
+
+TEST(TPrime_Stream, check_stream_of_reversed_interval_is_empty) {
+    // Arrange
+    TPrime_Stream stream(10, 5);
+    std::uint64_t prime;
+    // Act & Assert
+    EXPECT_FALSE(stream.Next(&prime));
+}
+
+TEST(TPrime_Stream, check_for_each_prime_from_0_to_10) {
+    // Arrange
+    std::vector<unsigned int> res;
+    // Act
+    ForEachPrime(0, 10, [&res](std::uint64_t prime) {
+        res.push_back(static_cast<unsigned int>(prime));
+    });
+    // Assert
+    EXPECT_TRUE(compare_vec(res, {2, 3, 5, 7}));
+}
+
+TEST(TPrime_Stream, check_for_each_prime_counts_up_to_ten_million) {
+    // Arrange
+    std::uint64_t count = 0;
+    // Act
+    ForEachPrime(0, 10000000, [&count](std::uint64_t) { ++count; });
+    // Assert
+    EXPECT_EQ(664579u, count);
+}
+
+TEST(TPrime_Stream, check_for_each_prime_near_10_to_12) {
+    // Arrange
+    const std::uint64_t left = 1000000000000ULL;
+    std::uint64_t count = 0, first = 0, last = 0;
+    // Act
+    ForEachPrime(left, left + 1000000,
+                 [&count, &first, &last](std::uint64_t prime) {
+        if (count++ == 0) first = prime;
+        EXPECT_LT(last, prime);
+        last = prime;
+    });
+    // Assert
+    EXPECT_EQ(36249u, count);
+    EXPECT_EQ(1000000000039ULL, first);
 }
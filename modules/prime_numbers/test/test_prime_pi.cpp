@@ -0,0 +1,41 @@
+// Copyright 2020 Kuzhelev Anton
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include "include/TPrime_Nums.h"
+
+TEST(Prime_Pi, matches_sieve_count_for_small_x) {
+    // Arrange
+    const std::uint64_t xs[] = {0, 1, 2, 3, 100, 4194303, 4194304, 4194305,
+                                5000011, 12345678, 33554432};
+    // Act & Assert
+    for (size_t i = 0; i < sizeof(xs) / sizeof(*xs); ++i) {
+        std::uint64_t count = 0;
+        ForEachPrime(0, xs[i], [&count](std::uint64_t) { ++count; });
+        EXPECT_EQ(count, TPrime_Nums::Prime_Pi(xs[i])) << xs[i];
+    }
+}
+
+TEST(Prime_Pi, can_count_primes_up_to_powers_of_ten) {
+    // Act & Assert
+    EXPECT_EQ(78498u, TPrime_Nums::Prime_Pi(1000000));
+    EXPECT_EQ(664579u, TPrime_Nums::Prime_Pi(10000000));
+    EXPECT_EQ(5761455u, TPrime_Nums::Prime_Pi(100000000));
+    EXPECT_EQ(50847534u, TPrime_Nums::Prime_Pi(1000000000));
+    EXPECT_EQ(455052511u, TPrime_Nums::Prime_Pi(10000000000ULL));
+}
+
+TEST(Prime_Pi, parallel_count_matches_sequential_one) {
+    // Act & Assert
+    EXPECT_EQ(4118054813ULL, TPrime_Nums::Prime_Pi(100000000000ULL, 4));
+    EXPECT_EQ(TPrime_Nums::Prime_Pi(2000000011ULL, 1),
+              TPrime_Nums::Prime_Pi(2000000011ULL, 3));
+}
+
+TEST(Prime_Pi, wide_interval_is_counted_by_prime_pi) {
+    // Act & Assert
+    EXPECT_EQ(454974013u,
+              TPrime_Nums::Count_Prime_Nums(1000000, 10000000000ULL, 2));
+    EXPECT_EQ(455052511u, TPrime_Nums::Count_Prime_Nums(0, 10000000000ULL, 2));
+}
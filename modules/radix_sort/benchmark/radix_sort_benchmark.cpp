@@ -0,0 +1,158 @@
+// Copyright 2020 Guschin Alexander
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <random>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "include/radix_sort.h"
+
+namespace {
+
+const std::uint32_t kSeed = 20200401;
+const std::size_t kMinSize = 1000;
+const std::size_t kMaxSize = 1000000000;
+const std::size_t kKeysPerMeasurement = 10000000;
+
+enum Distribution { kUniform, kSorted, kReverse, kFewUnique, kAllNegative };
+const char* const kDistributionNames[] = {"uniform", "sorted", "reverse",
+                                          "few-unique", "all-negative"};
+
+enum Algorithm { kRadixSort, kRadixSortInPlace, kRadixSortParallel, kStdSort };
+const char* const kAlgorithmNames[] = {"RadixSort", "InPlace", "Parallel",
+                                       "std::sort"};
+
+std::vector<std::int32_t> Generate(Distribution distribution,
+                                   std::size_t size) {
+  std::mt19937 gen(kSeed);
+  std::vector<std::int32_t> keys(size);
+  if (distribution == kFewUnique) {
+    std::int32_t values[16];
+    for (std::size_t i = 0; i < 16; ++i)
+      values[i] = static_cast<std::int32_t>(gen());
+    for (std::size_t i = 0; i < size; ++i) keys[i] = values[gen() % 16];
+    return keys;
+  }
+  for (std::size_t i = 0; i < size; ++i) {
+    keys[i] = static_cast<std::int32_t>(gen());
+    if (distribution == kAllNegative) keys[i] = -(keys[i] & 0x7FFFFFFF) - 1;
+  }
+  if (distribution == kSorted || distribution == kReverse)
+    std::sort(keys.begin(), keys.end());
+  if (distribution == kReverse) std::reverse(keys.begin(), keys.end());
+  return keys;
+}
+
+// Memory traffic model of each algorithm in bytes per 4-byte key:
+// a histogram read is 4 bytes, a scatter or a copy is 8 (read + write).
+// RadixSort and RadixSortParallel take their input by value, which is one
+// more copy.
+double BytesPerKey(Algorithm algorithm, std::size_t passes, std::size_t size,
+                   std::size_t threads_count) {
+  double in_place = 4.0 + 8.0 * passes + (passes % 2 != 0 ? 8.0 : 0.0);
+  switch (algorithm) {
+    case kRadixSort:
+      return in_place + 8.0;
+    case kRadixSortInPlace:
+      return in_place;
+    case kRadixSortParallel:
+      if (RadixSortParallelThreads(size, threads_count) == 1)
+        return in_place + 8.0;
+      return 8.0 + 4 * (4.0 + 8.0);
+    default:
+      return 0.0;
+  }
+}
+
+// Returns the total time of the sorts only, input copies are not measured.
+double Measure(Algorithm algorithm, const std::vector<std::int32_t>& input,
+               std::size_t repeats, std::size_t threads_count,
+               std::vector<std::int32_t>* output) {
+  std::chrono::steady_clock::duration total(0);
+  for (std::size_t r = 0; r < repeats; ++r) {
+    std::vector<std::int32_t> keys(input);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    switch (algorithm) {
+      case kRadixSort:
+        keys = RadixSort(keys);
+        break;
+      case kRadixSortInPlace:
+        RadixSortInPlace(&keys);
+        break;
+      case kRadixSortParallel:
+        keys = RadixSortParallel(keys, threads_count);
+        break;
+      case kStdSort:
+        std::sort(keys.begin(), keys.end());
+        break;
+    }
+    total += std::chrono::steady_clock::now() - start;
+    if (r + 1 == repeats) output->swap(keys);
+  }
+  return std::chrono::duration<double>(total).count();
+}
+
+bool ParseSize(const char* arg, std::size_t* value) {
+  char* end = nullptr;
+  double parsed = strtod(arg, &end);
+  if (end == arg || *end != '\0' || parsed < 1.0) return false;
+  *value = static_cast<std::size_t>(parsed);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  std::size_t max_size = kKeysPerMeasurement;
+  std::size_t threads_count = 0;
+  if ((argc > 1 && !ParseSize(argv[1], &max_size)) ||
+      (argc > 2 && !ParseSize(argv[2], &threads_count)) || argc > 3 ||
+      max_size < kMinSize || max_size > kMaxSize) {
+    printf("Usage: %s [max_size (1e3..1e9, default 1e7)] [threads]\n",
+           argv[0]);
+    return 1;
+  }
+  if (threads_count == 0)
+    threads_count = std::max(1u, std::thread::hardware_concurrency());
+
+  printf("Radix sort benchmark, seed %u, %u threads for Parallel\n",
+         static_cast<unsigned>(kSeed), static_cast<unsigned>(threads_count));
+  printf("%-13s %-10s %11s %16s %10s\n", "distribution", "algorithm",
+         "size", "throughput", "traffic");
+
+  for (std::size_t size = kMinSize; size <= max_size; size *= 10) {
+    std::size_t repeats = std::max<std::size_t>(1, kKeysPerMeasurement / size);
+    for (int d = kUniform; d <= kAllNegative; ++d) {
+      Distribution distribution = static_cast<Distribution>(d);
+      std::vector<std::int32_t> input = Generate(distribution, size);
+      std::vector<std::int32_t> probe(input);
+      std::size_t passes = RadixSortInPlace(&probe);
+
+      for (int a = kRadixSort; a <= kStdSort; ++a) {
+        Algorithm algorithm = static_cast<Algorithm>(a);
+        std::vector<std::int32_t> output;
+        double seconds = Measure(algorithm, input, repeats, threads_count,
+                                 &output);
+        double keys_per_second = size * repeats / seconds;
+        std::string traffic = "-";
+        if (algorithm != kStdSort) {
+          char buffer[32];
+          snprintf(buffer, sizeof(buffer), "%.0f B/key",
+                   BytesPerKey(algorithm, passes, size, threads_count));
+          traffic = buffer;
+        }
+        printf("%-13s %-10s %11u %10.2f Mkeys/s %10s%s\n",
+               kDistributionNames[d], kAlgorithmNames[a],
+               static_cast<unsigned>(size), keys_per_second / 1e6,
+               traffic.c_str(), output == probe ? "" : "  NOT SORTED");
+      }
+    }
+  }
+  return 0;
+}
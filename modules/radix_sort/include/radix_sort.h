@@ -3,10 +3,29 @@
 #ifndef MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_H_
 #define MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 void FillRandom(std::vector<std::int32_t>* vector_ptr);
 bool IsSorted(const std::vector<std::int32_t>& vector_ref);
 std::vector<std::int32_t> RadixSort(std::vector<std::int32_t> vector);
 
+// Sort without the per-pass copies of RadixSort: keys ping-pong between the
+// input and one scratch buffer, all byte histograms are read in one pre-pass
+// and passes where every key has the same digit are skipped.
+// Returns the number of scatter passes actually performed (0..4).
+std::size_t RadixSortInPlace(std::vector<std::int32_t>* vector_ptr);
+std::size_t RadixSortInPlace(std::int32_t* data, std::size_t size);
+
+// Multithreaded LSD variant: every pass builds per-thread byte histograms,
+// merges them into per-thread scatter offsets and scatters in parallel.
+// threads_count == 0 means "use all hardware threads".
+std::vector<std::int32_t> RadixSortParallel(std::vector<std::int32_t> vector,
+                                            std::size_t threads_count);
+// Threads RadixSortParallel really uses for size keys: every thread gets at
+// least 64K keys. With 1 it falls back to RadixSortInPlace.
+std::size_t RadixSortParallelThreads(std::size_t size,
+                                     std::size_t threads_count);
+
 #endif  // MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_H_
@@ -0,0 +1,19 @@
+// Copyright 2020 Guschin Alexander
+
+#ifndef MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_EXTERNAL_H_
+#define MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_EXTERNAL_H_
+
+#include <cstddef>
+#include <string>
+
+// Out-of-core sort of a file of raw native-endian int32_t keys.
+// The input is memory-mapped and MSD-partitioned by its top byte into bucket
+// files next to output_path; buckets that fit into memory_limit bytes are
+// finished with RadixSortInPlace, larger ones are partitioned again by the
+// next byte. All file I/O is sequential and heap usage stays within
+// memory_limit. Returns the number of sorted keys.
+std::size_t RadixSortFile(const std::string& input_path,
+                          const std::string& output_path,
+                          std::size_t memory_limit);
+
+#endif  // MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_EXTERNAL_H_
@@ -0,0 +1,169 @@
+// Copyright 2020 Guschin Alexander
+
+#ifndef MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_GENERIC_H_
+#define MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_GENERIC_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Maps a key to an unsigned integer whose natural order is the key order and
+// fixes the digit width; the pass count follows from both at compile time.
+template <typename Key>
+struct RadixKeyTraits;
+
+template <>
+struct RadixKeyTraits<std::uint32_t> {
+  typedef std::uint32_t Bits;
+  static const int kDigitBits = 11;
+  static Bits ToBits(std::uint32_t key) { return key; }
+};
+
+template <>
+struct RadixKeyTraits<std::int32_t> {
+  typedef std::uint32_t Bits;
+  static const int kDigitBits = 11;
+  static Bits ToBits(std::int32_t key) {
+    return static_cast<Bits>(key) ^ 0x80000000u;
+  }
+};
+
+template <>
+struct RadixKeyTraits<std::uint64_t> {
+  typedef std::uint64_t Bits;
+  static const int kDigitBits = 11;
+  static Bits ToBits(std::uint64_t key) { return key; }
+};
+
+template <>
+struct RadixKeyTraits<std::int64_t> {
+  typedef std::uint64_t Bits;
+  static const int kDigitBits = 11;
+  static Bits ToBits(std::int64_t key) {
+    return static_cast<Bits>(key) ^ 0x8000000000000000ull;
+  }
+};
+
+// IEEE keys: positive values get the sign bit set, negative values are
+// inverted completely. -0.0 sorts before +0.0, NaNs go to the ends.
+template <>
+struct RadixKeyTraits<float> {
+  typedef std::uint32_t Bits;
+  static const int kDigitBits = 11;
+  static Bits ToBits(float key) {
+    Bits bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  }
+};
+
+template <>
+struct RadixKeyTraits<double> {
+  typedef std::uint64_t Bits;
+  static const int kDigitBits = 11;
+  static Bits ToBits(double key) {
+    Bits bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits
+                                          : (bits | 0x8000000000000000ull);
+  }
+};
+
+namespace radix_detail {
+
+template <typename Key>
+struct Digits {
+  typedef RadixKeyTraits<Key> Traits;
+  typedef typename Traits::Bits Bits;
+  static const int kBits = Traits::kDigitBits;
+  static const int kPasses =
+      (8 * static_cast<int>(sizeof(Bits)) + kBits - 1) / kBits;
+  static const std::size_t kRadix = std::size_t(1) << kBits;
+
+  static std::size_t Get(const Key& key, int pass) {
+    return static_cast<std::size_t>(
+        (Traits::ToBits(key) >> (pass * kBits)) & (kRadix - 1));
+  }
+};
+
+// Stable LSD sort of keys (and values, if not null) with ping-pong buffers,
+// a single histogram pre-pass and skipping of passes with one distinct digit.
+template <typename Key, typename Value>
+void SortKeysValues(Key* keys, Value* values, std::size_t size) {
+  typedef Digits<Key> D;
+  if (size < 2) return;
+
+  std::vector<std::size_t> count(D::kPasses * D::kRadix, 0);
+  for (std::size_t i = 0; i < size; ++i)
+    for (int pass = 0; pass < D::kPasses; ++pass)
+      count[pass * D::kRadix + D::Get(keys[i], pass)]++;
+
+  std::vector<Key> key_buffer(size);
+  std::vector<Value> value_buffer(values ? size : 0);
+  Key* key_src = keys;
+  Key* key_dst = key_buffer.data();
+  Value* value_src = values;
+  Value* value_dst = value_buffer.data();
+
+  for (int pass = 0; pass < D::kPasses; ++pass) {
+    std::size_t* local = &count[pass * D::kRadix];
+    if (local[D::Get(key_src[0], pass)] == size) continue;
+
+    std::size_t sum = 0;
+    for (std::size_t b = 0; b < D::kRadix; ++b) {
+      std::size_t tmp = local[b];
+      local[b] = sum;
+      sum += tmp;
+    }
+
+    if (values) {
+      for (std::size_t i = 0; i < size; ++i) {
+        std::size_t pos = local[D::Get(key_src[i], pass)]++;
+        key_dst[pos] = key_src[i];
+        value_dst[pos] = value_src[i];
+      }
+      std::swap(value_src, value_dst);
+    } else {
+      for (std::size_t i = 0; i < size; ++i)
+        key_dst[local[D::Get(key_src[i], pass)]++] = key_src[i];
+    }
+    std::swap(key_src, key_dst);
+  }
+
+  if (key_src != keys) {
+    std::copy(key_src, key_src + size, keys);
+    if (values) std::copy(value_src, value_src + size, values);
+  }
+}
+
+}  // namespace radix_detail
+
+template <typename Key>
+void RadixSortKeys(std::vector<Key>* keys) {
+  radix_detail::SortKeysValues<Key, char>(keys->data(), nullptr,
+                                          keys->size());
+}
+
+// Sorts keys and applies the same (stable) permutation to values.
+template <typename Key, typename Value>
+void RadixSortPairs(std::vector<Key>* keys, std::vector<Value>* values) {
+  if (keys->size() != values->size())
+    throw "Keys and values have different sizes";
+  radix_detail::SortKeysValues(keys->data(), values->data(), keys->size());
+}
+
+// Returns the stable permutation p such that keys[p[0]], keys[p[1]], ...
+// is sorted; keys themselves are left untouched.
+template <typename Key>
+std::vector<std::size_t> RadixArgSort(const std::vector<Key>& keys) {
+  std::vector<Key> sorted_keys(keys);
+  std::vector<std::size_t> permutation(keys.size());
+  for (std::size_t i = 0; i < permutation.size(); ++i) permutation[i] = i;
+  radix_detail::SortKeysValues(sorted_keys.data(), permutation.data(),
+                               sorted_keys.size());
+  return permutation;
+}
+
+#endif  // MODULES_RADIX_SORT_INCLUDE_RADIX_SORT_GENERIC_H_
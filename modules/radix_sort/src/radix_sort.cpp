@@ -1,10 +1,70 @@
 // Copyright 2020 Guschin Alexander
 
 #include <time.h>
+#include <algorithm>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 #include <random>
 #include "include/radix_sort.h"
 
+namespace {
+
+const std::size_t kRadix = 256;
+const std::size_t kMinKeysPerThread = 1 << 16;
+
+// Digit of the key with the sign bit flipped, so that negative keys land in
+// the lower half of the top-byte buckets and no rotation is needed.
+inline std::size_t OrderedDigit(std::int32_t key, std::int32_t k) {
+  return ((static_cast<std::uint32_t>(key) ^ 0x80000000u) >> (8 * k)) & 0xFF;
+}
+
+// Sorts data, using buffer (of the same size) as the second ping-pong buffer.
+// All four histograms are built in a single pre-pass and passes where every
+// key has the same digit are skipped. Returns the number of scatter passes;
+// the result ends up in buffer if it is odd and in data otherwise.
+std::size_t SortPasses(std::int32_t* data, std::int32_t* buffer,
+                       std::size_t size) {
+  if (size < 2) return 0;
+
+  std::size_t count[4][kRadix] = {{0}};
+  for (std::size_t i = 0; i < size; ++i)
+    for (std::int32_t k = 0; k < 4; ++k) count[k][OrderedDigit(data[i], k)]++;
+
+  std::int32_t* src = data;
+  std::int32_t* dst = buffer;
+  std::size_t passes = 0;
+  for (std::int32_t k = 0; k < 4; ++k) {
+    std::size_t* local = count[k];
+    if (local[OrderedDigit(src[0], k)] == size) continue;
+
+    std::size_t sum = 0;
+    for (std::size_t b = 0; b < kRadix; ++b) {
+      std::size_t tmp = local[b];
+      local[b] = sum;
+      sum += tmp;
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+      dst[local[OrderedDigit(src[i], k)]++] = src[i];
+
+    std::swap(src, dst);
+    ++passes;
+  }
+  return passes;
+}
+
+template <typename Function>
+void RunInThreads(std::size_t threads_count, Function function) {
+  std::vector<std::thread> threads;
+  threads.reserve(threads_count - 1);
+  for (std::size_t t = 1; t < threads_count; ++t)
+    threads.push_back(std::thread(function, t));
+  function(0);
+  for (std::size_t t = 0; t < threads.size(); ++t) threads[t].join();
+}
+
+}  // namespace
+
 void FillRandom(std::vector<std::int32_t>* vector_ptr) {
   std::mt19937 gen(time(0));
   std::size_t size = vector_ptr->size();
@@ -24,46 +84,80 @@ bool IsSorted(const std::vector<std::int32_t>& vector_ref) {
 }
 
 std::vector<std::int32_t> RadixSort(std::vector<std::int32_t> vector) {
-  std::size_t size = vector.size();
-  std::vector<std::int32_t> res_vector(size);
-  std::uint8_t* ptr = reinterpret_cast<std::uint8_t*>(&vector[0]);
+  RadixSortInPlace(&vector);
+  return vector;
+}
 
-  for (std::int32_t k = 0; k < 3; ++k) {
-    std::int32_t count[256] = {0};
-    for (std::size_t i = 0; i < size; ++i) count[*(ptr + k + i * 4)]++;
+std::size_t RadixSortInPlace(std::vector<std::int32_t>* vector_ptr) {
+  std::vector<std::int32_t> buffer(vector_ptr->size());
+  std::size_t passes = SortPasses(vector_ptr->data(), buffer.data(),
+                                  buffer.size());
+  if (passes % 2 != 0) vector_ptr->swap(buffer);
+  return passes;
+}
 
-    std::int32_t sum = 0;
-    for (std::int32_t i = 0; i < 256; ++i) {
-      std::int32_t tmp = count[i];
-      count[i] = sum;
-      sum += tmp;
-    }
+std::size_t RadixSortInPlace(std::int32_t* data, std::size_t size) {
+  std::vector<std::int32_t> buffer(size);
+  std::size_t passes = SortPasses(data, buffer.data(), size);
+  if (passes % 2 != 0) std::copy(buffer.begin(), buffer.end(), data);
+  return passes;
+}
 
-    for (std::size_t i = 0; i < size; ++i) {
-      res_vector[count[*(ptr + k + i * 4)]] = vector[i];
-      count[*(ptr + k + i * 4)]++;
-    }
+std::size_t RadixSortParallelThreads(std::size_t size,
+                                     std::size_t threads_count) {
+  if (threads_count == 0) threads_count = std::thread::hardware_concurrency();
+  if (threads_count == 0) threads_count = 1;
+  threads_count = std::min(threads_count, size / kMinKeysPerThread);
+  return std::max<std::size_t>(threads_count, 1);
+}
 
-    vector = res_vector;
+std::vector<std::int32_t> RadixSortParallel(std::vector<std::int32_t> vector,
+                                            std::size_t threads_count) {
+  std::size_t size = vector.size();
+  threads_count = RadixSortParallelThreads(size, threads_count);
+  if (threads_count == 1) {
+    RadixSortInPlace(&vector);
+    return vector;
   }
 
-  std::int32_t count[256] = {0};
-  for (std::size_t i = 0; i < size; ++i) count[*(ptr + 3 + i * 4)]++;
+  std::vector<std::int32_t> res_vector(size);
+  std::vector<std::size_t> count(threads_count * kRadix);
+  std::size_t chunk = (size + threads_count - 1) / threads_count;
 
-  std::int32_t shift = 0;
-  for (std::int32_t i = 128; i < 256; ++i) shift += count[i];
+  for (std::int32_t k = 0; k < 4; ++k) {
+    const std::int32_t* src = vector.data();
+    std::int32_t* dst = res_vector.data();
+    std::size_t* count_ptr = count.data();
 
-  std::int32_t sum = 0;
-  for (std::int32_t i = 0; i < 256; ++i) {
-    std::int32_t tmp = count[i];
-    count[i] = sum;
-    sum += tmp;
-  }
+    RunInThreads(threads_count, [src, count_ptr, chunk, size, k](
+                                    std::size_t t) {
+      std::size_t* local = count_ptr + t * kRadix;
+      std::fill(local, local + kRadix, 0);
+      std::size_t end = std::min(size, (t + 1) * chunk);
+      for (std::size_t i = t * chunk; i < end; ++i)
+        local[OrderedDigit(src[i], k)]++;
+    });
 
-  for (std::size_t i = 0; i < size; ++i) {
-    res_vector[(count[*(ptr + 3 + i * 4)] + shift) % size] = vector[i];
-    count[*(ptr + 3 + i * 4)]++;
+    // Bucket-major, thread-minor prefix sum keeps the sort stable.
+    std::size_t sum = 0;
+    for (std::size_t b = 0; b < kRadix; ++b) {
+      for (std::size_t t = 0; t < threads_count; ++t) {
+        std::size_t tmp = count[t * kRadix + b];
+        count[t * kRadix + b] = sum;
+        sum += tmp;
+      }
+    }
+
+    RunInThreads(threads_count, [src, dst, count_ptr, chunk, size, k](
+                                    std::size_t t) {
+      std::size_t* local = count_ptr + t * kRadix;
+      std::size_t end = std::min(size, (t + 1) * chunk);
+      for (std::size_t i = t * chunk; i < end; ++i)
+        dst[local[OrderedDigit(src[i], k)]++] = src[i];
+    });
+
+    vector.swap(res_vector);
   }
 
-  return res_vector;
+  return vector;
 }
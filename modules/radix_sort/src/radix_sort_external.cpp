@@ -0,0 +1,274 @@
+// Copyright 2020 Guschin Alexander
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "include/radix_sort.h"
+#include "include/radix_sort_external.h"
+
+namespace {
+
+const std::size_t kRadix = 256;
+const std::size_t kMinMemoryLimit = 1 << 15;
+
+// Read-only mapping of a whole file of int32_t keys.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+  const std::int32_t* Keys() const { return keys; }
+  std::size_t Size() const { return size; }
+
+ private:
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+
+  const std::int32_t* keys;
+  std::size_t size;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+};
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& path)
+    : keys(nullptr), size(0), file(INVALID_HANDLE_VALUE), mapping(nullptr) {
+  file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                     OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) throw "Cannot open input file";
+  LARGE_INTEGER bytes;
+  GetFileSizeEx(file, &bytes);
+  if (bytes.QuadPart % sizeof(std::int32_t) != 0) {
+    CloseHandle(file);
+    throw "File size is not a multiple of the key size";
+  }
+  size = static_cast<std::size_t>(bytes.QuadPart) / sizeof(std::int32_t);
+  if (size == 0) return;
+  mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+                       : nullptr;
+  if (view == nullptr) {
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    throw "Cannot map input file";
+  }
+  keys = static_cast<const std::int32_t*>(view);
+}
+
+MappedFile::~MappedFile() {
+  if (keys) UnmapViewOfFile(keys);
+  if (mapping) CloseHandle(mapping);
+  CloseHandle(file);
+}
+#else
+MappedFile::MappedFile(const std::string& path) : keys(nullptr), size(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw "Cannot open input file";
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size % sizeof(std::int32_t) != 0) {
+    close(fd);
+    throw "File size is not a multiple of the key size";
+  }
+  size = static_cast<std::size_t>(info.st_size) / sizeof(std::int32_t);
+  if (size != 0) {
+    void* view = mmap(nullptr, size * sizeof(std::int32_t), PROT_READ,
+                      MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+      close(fd);
+      throw "Cannot map input file";
+    }
+    madvise(view, size * sizeof(std::int32_t), MADV_SEQUENTIAL);
+    keys = static_cast<const std::int32_t*>(view);
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (keys)
+    munmap(const_cast<std::int32_t*>(keys), size * sizeof(std::int32_t));
+}
+#endif
+
+// Whether both paths name one existing file, through links or not.
+#ifdef _WIN32
+bool SameFile(const std::string& first, const std::string& second) {
+  BY_HANDLE_FILE_INFORMATION info[2];
+  const std::string* paths[2] = {&first, &second};
+  for (int i = 0; i < 2; ++i) {
+    HANDLE file = CreateFileA(paths[i]->c_str(), 0,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE |
+                                  FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, 0, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    BOOL ok = GetFileInformationByHandle(file, &info[i]);
+    CloseHandle(file);
+    if (!ok) return false;
+  }
+  return info[0].dwVolumeSerialNumber == info[1].dwVolumeSerialNumber &&
+         info[0].nFileIndexHigh == info[1].nFileIndexHigh &&
+         info[0].nFileIndexLow == info[1].nFileIndexLow;
+}
+#else
+bool SameFile(const std::string& first, const std::string& second) {
+  struct stat first_info;
+  struct stat second_info;
+  return stat(first.c_str(), &first_info) == 0 &&
+         stat(second.c_str(), &second_info) == 0 &&
+         first_info.st_dev == second_info.st_dev &&
+         first_info.st_ino == second_info.st_ino;
+}
+#endif
+
+// Byte that orders keys at the given MSD depth; the top byte has its sign bit
+// flipped so that negative keys come first.
+inline std::size_t MsdDigit(std::int32_t key, int depth) {
+  std::uint32_t bits = static_cast<std::uint32_t>(key) ^ 0x80000000u;
+  return (bits >> (8 * (3 - depth))) & 0xFF;
+}
+
+void WriteKeys(const std::int32_t* keys, std::size_t size, std::FILE* out) {
+  if (size != 0 && std::fwrite(keys, sizeof(std::int32_t), size, out) != size)
+    throw "Cannot write output file";
+}
+
+// Buffered, append-only writer of 256 bucket files. The files belong to the
+// writer until Remove: whatever is left is deleted by the destructor, so an
+// exception does not leave buckets behind.
+class BucketWriter {
+ public:
+  BucketWriter(const std::string& prefix_, std::size_t capacity_)
+      : prefix(prefix_), capacity(capacity_), files(kRadix, nullptr),
+        created(kRadix, false), buffers(kRadix), counts(kRadix, 0) {}
+  ~BucketWriter() {
+    for (std::size_t b = 0; b < kRadix; ++b) {
+      if (files[b]) std::fclose(files[b]);
+      if (created[b]) std::remove(Name(b).c_str());
+    }
+  }
+
+  void Add(std::size_t bucket, std::int32_t key) {
+    std::vector<std::int32_t>& buffer = buffers[bucket];
+    if (buffer.capacity() < capacity) buffer.reserve(capacity);
+    buffer.push_back(key);
+    if (buffer.size() == capacity) Flush(bucket);
+  }
+
+  // Flushes and closes every file; buffers are released.
+  void Close() {
+    for (std::size_t b = 0; b < kRadix; ++b) {
+      Flush(b);
+      std::vector<std::int32_t>().swap(buffers[b]);
+      if (files[b]) std::fclose(files[b]);
+      files[b] = nullptr;
+    }
+  }
+
+  void Remove(std::size_t bucket) {
+    std::remove(Name(bucket).c_str());
+    created[bucket] = false;
+  }
+
+  std::size_t Count(std::size_t bucket) const { return counts[bucket]; }
+  std::string Name(std::size_t bucket) const {
+    return prefix + "." + std::to_string(bucket);
+  }
+
+ private:
+  BucketWriter(const BucketWriter&);
+  BucketWriter& operator=(const BucketWriter&);
+
+  void Flush(std::size_t bucket) {
+    std::vector<std::int32_t>& buffer = buffers[bucket];
+    if (buffer.empty()) return;
+    if (files[bucket] == nullptr) {
+      files[bucket] = std::fopen(Name(bucket).c_str(), "wb");
+      if (files[bucket] == nullptr) throw "Cannot create bucket file";
+      created[bucket] = true;
+    }
+    WriteKeys(buffer.data(), buffer.size(), files[bucket]);
+    counts[bucket] += buffer.size();
+    buffer.clear();
+  }
+
+  std::string prefix;
+  std::size_t capacity;
+  std::vector<std::FILE*> files;
+  std::vector<bool> created;
+  std::vector<std::vector<std::int32_t> > buffers;
+  std::vector<std::size_t> counts;
+};
+
+void SortRange(const std::int32_t* keys, std::size_t size, int depth,
+               const std::string& prefix, std::size_t memory_limit,
+               std::FILE* out) {
+  // RadixSortInPlace needs the keys plus one scratch buffer of the same size.
+  if (size * 2 * sizeof(std::int32_t) <= memory_limit) {
+    std::vector<std::int32_t> chunk(keys, keys + size);
+    RadixSortInPlace(&chunk);
+    WriteKeys(chunk.data(), chunk.size(), out);
+    return;
+  }
+  // Every byte has been partitioned on: all keys of the bucket are equal.
+  if (depth == 4) {
+    WriteKeys(keys, size, out);
+    return;
+  }
+
+  BucketWriter writer(prefix,
+                      memory_limit / 2 / kRadix / sizeof(std::int32_t));
+  for (std::size_t i = 0; i < size; ++i)
+    writer.Add(MsdDigit(keys[i], depth), keys[i]);
+  writer.Close();
+
+  for (std::size_t b = 0; b < kRadix; ++b) {
+    if (writer.Count(b) == 0) continue;
+    std::string name = writer.Name(b);
+    {
+      MappedFile bucket(name);
+      SortRange(bucket.Keys(), bucket.Size(), depth + 1, name, memory_limit,
+                out);
+    }
+    writer.Remove(b);
+  }
+}
+
+}  // namespace
+
+std::size_t RadixSortFile(const std::string& input_path,
+                          const std::string& output_path,
+                          std::size_t memory_limit) {
+  if (memory_limit < kMinMemoryLimit) throw "Memory limit is too small";
+
+  MappedFile input(input_path);
+  // Opening the output truncates it, which would pull the mapped keys away.
+  if (SameFile(input_path, output_path))
+    throw "Output file is the input file";
+  std::FILE* out = std::fopen(output_path.c_str(), "wb");
+  if (out == nullptr) throw "Cannot create output file";
+  // A failed sort leaves no partial output behind.
+  try {
+    SortRange(input.Keys(), input.Size(), 0, output_path + ".bucket",
+              memory_limit, out);
+  } catch (...) {
+    std::fclose(out);
+    std::remove(output_path.c_str());
+    throw;
+  }
+  if (std::fclose(out) != 0) {
+    std::remove(output_path.c_str());
+    throw "Cannot write output file";
+  }
+  return input.Size();
+}
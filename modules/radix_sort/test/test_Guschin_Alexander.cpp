@@ -90,3 +90,133 @@ TEST(RadixSortTest, Can_Sort_Unsorted_Array_With_Random_Numbers) {
   // Assert
   EXPECT_TRUE(result);
 }
+
+TEST(RadixSortTest, Parallel_Can_Sort_Unsorted_Array_With_Negative_Numbers) {
+  // Arrange
+  std::vector<std::int32_t> vec = {
+      -32, 332, 1 << 28, -8, 1 << 26, -(1 << 26), -24, -(1 << 27), 1111};
+  std::vector<std::int32_t> expected_vec = {
+      -(1 << 27), -(1 << 26), -32, -24, -8, 332, 1111, 1 << 26, 1 << 28};
+
+  // Act
+  std::vector<std::int32_t> res(RadixSortParallel(vec, 4));
+
+  // Assert
+  EXPECT_EQ(expected_vec, res);
+}
+
+TEST(RadixSortTest, Parallel_Can_Sort_Large_Array_With_Random_Numbers) {
+  // Arrange
+  std::vector<std::int32_t> vec(1 << 20, 0);
+  FillRandom(&vec);
+
+  // Act
+  std::vector<std::int32_t> res(RadixSortParallel(vec, 4));
+
+  // Assert
+  EXPECT_TRUE(IsSorted(res));
+  EXPECT_EQ(RadixSort(vec), res);
+}
+
+TEST(RadixSortTest, Parallel_Can_Sort_Large_Array_Of_Negative_Numbers) {
+  // Arrange
+  std::vector<std::int32_t> vec(1 << 20, 0);
+  FillRandom(&vec);
+  for (std::size_t i = 0; i < vec.size(); ++i)
+    if (vec[i] > 0 && i % 4 != 0) vec[i] = -vec[i];
+
+  // Act
+  std::vector<std::int32_t> res(RadixSortParallel(vec, 4));
+
+  // Assert
+  EXPECT_EQ(RadixSort(vec), res);
+}
+
+TEST(RadixSortTest, Parallel_Can_Use_All_Hardware_Threads) {
+  // Arrange
+  std::vector<std::int32_t> vec(1 << 20, 0);
+  FillRandom(&vec);
+
+  // Act
+  bool result = IsSorted(RadixSortParallel(vec, 0));
+
+  // Assert
+  EXPECT_TRUE(result);
+}
+
+TEST(RadixSortTest, Parallel_Can_Sort_Empty_Array) {
+  // Arrange
+  std::vector<std::int32_t> vec;
+
+  // Act
+  std::vector<std::int32_t> res(RadixSortParallel(vec, 8));
+
+  // Assert
+  EXPECT_TRUE(res.empty());
+}
+
+TEST(RadixSortTest, Parallel_Falls_Back_To_One_Thread_For_Small_Arrays) {
+  // Arrange
+  std::size_t size = 1 << 17;
+
+  // Act
+  std::size_t small = RadixSortParallelThreads(size - 1, 8);
+  std::size_t large = RadixSortParallelThreads(size, 8);
+  std::size_t single = RadixSortParallelThreads(size * 8, 1);
+
+  // Assert
+  EXPECT_EQ(1u, small);
+  EXPECT_EQ(2u, large);
+  EXPECT_EQ(1u, single);
+}
+
+TEST(RadixSortTest, In_Place_Can_Sort_Unsorted_Array_With_Negative_Numbers) {
+  // Arrange
+  std::vector<std::int32_t> vec = {
+      -32, 332, 1 << 28, -8, 1 << 26, -(1 << 26), -24, -(1 << 27), 1111};
+  std::vector<std::int32_t> expected_vec = {
+      -(1 << 27), -(1 << 26), -32, -24, -8, 332, 1111, 1 << 26, 1 << 28};
+
+  // Act
+  RadixSortInPlace(&vec);
+
+  // Assert
+  EXPECT_EQ(expected_vec, vec);
+}
+
+TEST(RadixSortTest, In_Place_Can_Sort_Raw_Array_With_Random_Numbers) {
+  // Arrange
+  std::vector<std::int32_t> vec(1000, 0);
+  FillRandom(&vec);
+
+  // Act
+  RadixSortInPlace(vec.data(), vec.size());
+
+  // Assert
+  EXPECT_TRUE(IsSorted(vec));
+}
+
+TEST(RadixSortTest, In_Place_Skips_Passes_With_Equal_Digits) {
+  // Arrange
+  std::vector<std::int32_t> vec = {200, 3, 17, 255, 0, 42};
+  std::vector<std::int32_t> expected_vec = {0, 3, 17, 42, 200, 255};
+
+  // Act
+  std::size_t passes = RadixSortInPlace(vec.data(), vec.size());
+
+  // Assert
+  EXPECT_EQ(1u, passes);
+  EXPECT_EQ(expected_vec, vec);
+}
+
+TEST(RadixSortTest, In_Place_Does_No_Passes_For_Equal_Keys) {
+  // Arrange
+  std::vector<std::int32_t> vec(10, -7);
+
+  // Act
+  std::size_t passes = RadixSortInPlace(&vec);
+
+  // Assert
+  EXPECT_EQ(0u, passes);
+  EXPECT_EQ(std::vector<std::int32_t>(10, -7), vec);
+}
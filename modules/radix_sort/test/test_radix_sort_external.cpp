@@ -0,0 +1,175 @@
+// Copyright 2020 Guschin Alexander
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "include/radix_sort_external.h"
+
+namespace {
+
+void WriteFile(const std::string& path, const std::vector<std::int32_t>& v) {
+  std::ofstream out(path.c_str(), std::ios::binary);
+  out.write(reinterpret_cast<const char*>(v.data()),
+            v.size() * sizeof(std::int32_t));
+}
+
+std::vector<std::int32_t> ReadFile(const std::string& path) {
+  std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+  std::vector<std::int32_t> v(static_cast<std::size_t>(in.tellg()) /
+                              sizeof(std::int32_t));
+  in.seekg(0);
+  in.read(reinterpret_cast<char*>(v.data()), v.size() * sizeof(std::int32_t));
+  return v;
+}
+
+bool FileExists(const std::string& path) {
+  return std::ifstream(path.c_str()).good();
+}
+
+void MakeDirectory(const std::string& path) {
+#ifdef _WIN32
+  _mkdir(path.c_str());
+#else
+  mkdir(path.c_str(), 0700);
+#endif
+}
+
+void RemoveDirectory(const std::string& path) {
+#ifdef _WIN32
+  _rmdir(path.c_str());
+#else
+  rmdir(path.c_str());
+#endif
+}
+
+}  // namespace
+
+TEST(RadixSortExternalTest, Can_Sort_File_That_Fits_In_Memory) {
+  // Arrange
+  std::vector<std::int32_t> keys = {5, -1, 1 << 30, -(1 << 30), 0};
+  WriteFile("radix_small.in", keys);
+  std::sort(keys.begin(), keys.end());
+
+  // Act
+  std::size_t size = RadixSortFile("radix_small.in", "radix_small.out",
+                                   1 << 20);
+
+  // Assert
+  EXPECT_EQ(keys.size(), size);
+  EXPECT_EQ(keys, ReadFile("radix_small.out"));
+  std::remove("radix_small.in");
+  std::remove("radix_small.out");
+}
+
+TEST(RadixSortExternalTest, Can_Sort_File_Larger_Than_Memory_Limit) {
+  // Arrange
+  std::mt19937 gen(1);
+  std::vector<std::int32_t> keys(200000);
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    keys[i] = static_cast<std::int32_t>(gen());
+  // A heavy bucket forces a second partitioning level.
+  for (std::size_t i = 0; i < keys.size(); i += 2) keys[i] &= 0x00FFFFFF;
+  WriteFile("radix_large.in", keys);
+  std::sort(keys.begin(), keys.end());
+
+  // Act
+  RadixSortFile("radix_large.in", "radix_large.out", 1 << 16);
+
+  // Assert
+  EXPECT_EQ(keys, ReadFile("radix_large.out"));
+  std::remove("radix_large.in");
+  std::remove("radix_large.out");
+}
+
+TEST(RadixSortExternalTest, Can_Sort_File_Of_Equal_Keys) {
+  // Arrange
+  std::vector<std::int32_t> keys(50000, -42);
+  WriteFile("radix_equal.in", keys);
+
+  // Act
+  RadixSortFile("radix_equal.in", "radix_equal.out", 1 << 15);
+
+  // Assert
+  EXPECT_EQ(keys, ReadFile("radix_equal.out"));
+  std::remove("radix_equal.in");
+  std::remove("radix_equal.out");
+}
+
+TEST(RadixSortExternalTest, Can_Sort_Empty_File) {
+  // Arrange
+  WriteFile("radix_empty.in", std::vector<std::int32_t>());
+
+  // Act
+  std::size_t size = RadixSortFile("radix_empty.in", "radix_empty.out",
+                                   1 << 15);
+
+  // Assert
+  EXPECT_EQ(0u, size);
+  EXPECT_TRUE(ReadFile("radix_empty.out").empty());
+  std::remove("radix_empty.in");
+  std::remove("radix_empty.out");
+}
+
+TEST(RadixSortExternalTest, Cannot_Sort_Missing_File) {
+  // Act & Assert
+  EXPECT_ANY_THROW(RadixSortFile("radix_missing.in", "radix_missing.out",
+                                 1 << 20));
+}
+
+TEST(RadixSortExternalTest, Cannot_Sort_With_Tiny_Memory_Limit) {
+  // Arrange
+  WriteFile("radix_tiny.in", std::vector<std::int32_t>(10, 1));
+
+  // Act & Assert
+  EXPECT_ANY_THROW(RadixSortFile("radix_tiny.in", "radix_tiny.out", 1024));
+  std::remove("radix_tiny.in");
+}
+
+TEST(RadixSortExternalTest, Failed_Sort_Removes_Bucket_Files) {
+  // Arrange
+  std::mt19937 gen(2);
+  std::vector<std::int32_t> keys(200000);
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    keys[i] = static_cast<std::int32_t>(gen());
+  WriteFile("radix_fail.in", keys);
+  // Bucket 200 cannot be created, after other buckets already were.
+  MakeDirectory("radix_fail.out.bucket.200");
+
+  // Act
+  EXPECT_ANY_THROW(RadixSortFile("radix_fail.in", "radix_fail.out", 1 << 16));
+
+  // Assert
+  for (int b = 0; b < 256; ++b) {
+    if (b == 200) continue;
+    EXPECT_FALSE(FileExists("radix_fail.out.bucket." + std::to_string(b)));
+  }
+  EXPECT_FALSE(FileExists("radix_fail.out"));
+  RemoveDirectory("radix_fail.out.bucket.200");
+  std::remove("radix_fail.in");
+}
+
+TEST(RadixSortExternalTest, Cannot_Sort_File_Into_Itself) {
+  // Arrange
+  std::vector<std::int32_t> keys = {3, -7, 1, 0};
+  WriteFile("radix_self.in", keys);
+
+  // Act & Assert
+  EXPECT_ANY_THROW(RadixSortFile("radix_self.in", "radix_self.in", 1 << 20));
+  EXPECT_ANY_THROW(RadixSortFile("radix_self.in", "./radix_self.in",
+                                 1 << 20));
+  EXPECT_EQ(keys, ReadFile("radix_self.in"));
+  std::remove("radix_self.in");
+}
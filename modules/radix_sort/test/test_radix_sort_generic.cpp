@@ -0,0 +1,119 @@
+// Copyright 2020 Guschin Alexander
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "include/radix_sort_generic.h"
+
+TEST(RadixSortGenericTest, Can_Sort_Unsigned_32_Bit_Keys) {
+  // Arrange
+  std::vector<std::uint32_t> keys = {4000000000u, 7u, 0u, 65536u, 2048u};
+  std::vector<std::uint32_t> expected = {0u, 7u, 2048u, 65536u, 4000000000u};
+
+  // Act
+  RadixSortKeys(&keys);
+
+  // Assert
+  EXPECT_EQ(expected, keys);
+}
+
+TEST(RadixSortGenericTest, Can_Sort_Signed_64_Bit_Keys) {
+  // Arrange
+  std::vector<std::int64_t> keys = {
+      std::numeric_limits<std::int64_t>::max(), -1, 1LL << 40, 0,
+      -(1LL << 50), std::numeric_limits<std::int64_t>::min()};
+  std::vector<std::int64_t> expected(keys);
+  std::sort(expected.begin(), expected.end());
+
+  // Act
+  RadixSortKeys(&keys);
+
+  // Assert
+  EXPECT_EQ(expected, keys);
+}
+
+TEST(RadixSortGenericTest, Can_Sort_Random_Unsigned_64_Bit_Keys) {
+  // Arrange
+  std::mt19937_64 gen(42);
+  std::vector<std::uint64_t> keys(10000);
+  for (std::size_t i = 0; i < keys.size(); ++i) keys[i] = gen();
+  std::vector<std::uint64_t> expected(keys);
+  std::sort(expected.begin(), expected.end());
+
+  // Act
+  RadixSortKeys(&keys);
+
+  // Assert
+  EXPECT_EQ(expected, keys);
+}
+
+TEST(RadixSortGenericTest, Can_Sort_Float_Keys) {
+  // Arrange
+  std::vector<float> keys = {3.5f, -0.25f, 0.0f, -1e30f, 1e-30f,
+                             std::numeric_limits<float>::infinity(), -2.0f};
+  std::vector<float> expected(keys);
+  std::sort(expected.begin(), expected.end());
+
+  // Act
+  RadixSortKeys(&keys);
+
+  // Assert
+  EXPECT_EQ(expected, keys);
+}
+
+TEST(RadixSortGenericTest, Can_Sort_Random_Double_Keys) {
+  // Arrange
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(-1e6, 1e6);
+  std::vector<double> keys(10000);
+  for (std::size_t i = 0; i < keys.size(); ++i) keys[i] = dist(gen);
+  std::vector<double> expected(keys);
+  std::sort(expected.begin(), expected.end());
+
+  // Act
+  RadixSortKeys(&keys);
+
+  // Assert
+  EXPECT_EQ(expected, keys);
+}
+
+TEST(RadixSortGenericTest, Can_Sort_Pairs_Stably) {
+  // Arrange
+  std::vector<std::int32_t> keys = {5, -3, 5, 0, -3};
+  std::vector<std::string> values = {"a", "b", "c", "d", "e"};
+  std::vector<std::int32_t> expected_keys = {-3, -3, 0, 5, 5};
+  std::vector<std::string> expected_values = {"b", "e", "d", "a", "c"};
+
+  // Act
+  RadixSortPairs(&keys, &values);
+
+  // Assert
+  EXPECT_EQ(expected_keys, keys);
+  EXPECT_EQ(expected_values, values);
+}
+
+TEST(RadixSortGenericTest, Cannot_Sort_Pairs_With_Different_Sizes) {
+  // Arrange
+  std::vector<std::int32_t> keys = {1, 2};
+  std::vector<std::int32_t> values = {1};
+
+  // Act & Assert
+  EXPECT_ANY_THROW(RadixSortPairs(&keys, &values));
+}
+
+TEST(RadixSortGenericTest, Can_Arg_Sort) {
+  // Arrange
+  std::vector<double> keys = {0.5, -1.5, 2.5, -1.5};
+  std::vector<std::size_t> expected = {1, 3, 0, 2};
+
+  // Act
+  std::vector<std::size_t> permutation = RadixArgSort(keys);
+
+  // Assert
+  EXPECT_EQ(expected, permutation);
+  EXPECT_EQ(0.5, keys[0]);
+}